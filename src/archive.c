@@ -0,0 +1,195 @@
+// src/archive.c
+#define _POSIX_C_SOURCE 200809L
+#include "archive.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define ARCHIVE_HEADER_SIZE 16
+
+// --- MAPPING ---
+#if defined(_WIN32)
+static bool MapFile(Archive *archive, const char *fileName) {
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(file);      // the mapping keeps the file open
+    if (mapping == NULL) return false;
+
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    archive->data = view;
+    archive->size = (size_t)size.QuadPart;
+    archive->handle = mapping;
+    return true;
+}
+
+static void UnmapFile(Archive *archive) {
+    UnmapViewOfFile(archive->data);
+    CloseHandle((HANDLE)archive->handle);
+}
+#else
+static bool MapFile(Archive *archive, const char *fileName) {
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    void *view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);              // the mapping keeps the file open
+    if (view == MAP_FAILED) return false;
+
+    archive->data = view;
+    archive->size = (size_t)info.st_size;
+    return true;
+}
+
+static void UnmapFile(Archive *archive) {
+    munmap((void *)archive->data, archive->size);
+}
+#endif
+
+// --- READING ---
+static unsigned int ReadU32(const unsigned char *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+// Everything the index points at must lie inside the file
+static bool ValidArchive(const Archive *archive, unsigned int indexOffset) {
+    size_t indexSize = (size_t)archive->entryCount * sizeof(ArchiveEntry);
+    if (archive->entryCount > ARCHIVE_MAX_ENTRIES) return false;
+    if (indexOffset % ARCHIVE_ALIGN != 0 || indexOffset > archive->size) return false;
+    if (indexSize > archive->size - indexOffset) return false;
+
+    const ArchiveEntry *entries = (const ArchiveEntry *)(archive->data + indexOffset);
+    for (int i = 0; i < archive->entryCount; i++) {
+        const ArchiveEntry *entry = &entries[i];
+        if (memchr(entry->name, '\0', ARCHIVE_NAME_LENGTH) == NULL) return false;
+        if (entry->offset % ARCHIVE_ALIGN != 0 || entry->offset > archive->size) return false;
+        if (entry->size > archive->size - entry->offset) return false;
+    }
+    return true;
+}
+
+bool OpenArchive(Archive *archive, const char *fileName) {
+    memset(archive, 0, sizeof(*archive));
+    if (!MapFile(archive, fileName)) return false;
+
+    const unsigned char *header = archive->data;
+    unsigned int indexOffset = 0;
+    bool ok = archive->size >= ARCHIVE_HEADER_SIZE && memcmp(header, "FBPK", 4) == 0 &&
+              ReadU32(header + 4) == ARCHIVE_VERSION;
+    if (ok) {
+        archive->entryCount = (int)ReadU32(header + 8);
+        indexOffset = ReadU32(header + 12);
+        ok = ValidArchive(archive, indexOffset);
+    }
+    if (!ok) {
+        CloseArchive(archive);
+        return false;
+    }
+
+    archive->entries = (const ArchiveEntry *)(archive->data + indexOffset);
+    return true;
+}
+
+void CloseArchive(Archive *archive) {
+    if (archive->data != NULL) UnmapFile(archive);
+    memset(archive, 0, sizeof(*archive));
+}
+
+const ArchiveEntry *FindArchiveEntry(const Archive *archive, const char *name) {
+    for (int i = 0; i < archive->entryCount; i++) {
+        if (strcmp(archive->entries[i].name, name) == 0) return &archive->entries[i];
+    }
+    return NULL;
+}
+
+const void *ArchiveEntryData(const Archive *archive, const ArchiveEntry *entry) {
+    return archive->data + entry->offset;
+}
+
+// --- WRITING ---
+bool AddArchiveEntry(ArchiveWriter *writer, const char *name, ArchiveEntryType type,
+                     const unsigned int params[4], const void *data, unsigned int size) {
+    if (writer->entryCount == ARCHIVE_MAX_ENTRIES || strlen(name) >= ARCHIVE_NAME_LENGTH) return false;
+
+    ArchiveEntry *entry = &writer->entries[writer->entryCount];
+    memset(entry, 0, sizeof(*entry));
+    strcpy(entry->name, name);
+    entry->type = type;
+    entry->size = size;
+    if (params != NULL) memcpy(entry->params, params, sizeof(entry->params));
+
+    writer->payloads[writer->entryCount++] = data;
+    return true;
+}
+
+static void WriteU32(FILE *file, unsigned int value) {
+    unsigned char bytes[4] = {
+        (unsigned char)value, (unsigned char)(value >> 8),
+        (unsigned char)(value >> 16), (unsigned char)(value >> 24)
+    };
+    fwrite(bytes, 1, 4, file);
+}
+
+// Zero-fills up to the next ARCHIVE_ALIGN boundary and returns the new offset
+static unsigned int PadToAlign(FILE *file, unsigned int offset) {
+    static const unsigned char zeros[ARCHIVE_ALIGN] = { 0 };
+    unsigned int pad = (ARCHIVE_ALIGN - offset % ARCHIVE_ALIGN) % ARCHIVE_ALIGN;
+    fwrite(zeros, 1, pad, file);
+    return offset + pad;
+}
+
+bool SaveArchive(const ArchiveWriter *writer, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (!file) return false;
+
+    ArchiveEntry entries[ARCHIVE_MAX_ENTRIES];
+    memcpy(entries, writer->entries, sizeof(entries));
+
+    // Header is rewritten once the index offset is known
+    fwrite("FBPK", 1, 4, file);
+    WriteU32(file, ARCHIVE_VERSION);
+    WriteU32(file, (unsigned int)writer->entryCount);
+    WriteU32(file, 0);
+    unsigned int offset = ARCHIVE_HEADER_SIZE;
+
+    for (int i = 0; i < writer->entryCount; i++) {
+        offset = PadToAlign(file, offset);
+        entries[i].offset = offset;
+        fwrite(writer->payloads[i], 1, entries[i].size, file);
+        offset += entries[i].size;
+    }
+
+    unsigned int indexOffset = PadToAlign(file, offset);
+    fwrite(entries, sizeof(ArchiveEntry), writer->entryCount, file);
+
+    fseek(file, 12, SEEK_SET);
+    WriteU32(file, indexOffset);
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,61 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// --- ARCHIVE FORMAT ---
+// "FBPK" | version u32 | entry count u32 | index offset u32 | payloads | index.
+// Every payload starts on an ARCHIVE_ALIGN boundary and is used in place from the
+// mapping, so the archive holds little-endian data and is only read on such hosts.
+#define ARCHIVE_VERSION     1
+#define ARCHIVE_ALIGN       64
+#define ARCHIVE_NAME_LENGTH 24
+#define ARCHIVE_MAX_ENTRIES 32
+
+typedef enum ArchiveEntryType {
+    ARCHIVE_RAW,            // opaque bytes
+    ARCHIVE_IMAGE,          // params: width, height, pixel format
+    ARCHIVE_WAVE            // params: frame count, sample rate, sample size, channels
+} ArchiveEntryType;
+
+// --- STRUCTURES ---
+// Stored as-is in the index (52 bytes, no padding)
+typedef struct ArchiveEntry {
+    char name[ARCHIVE_NAME_LENGTH];
+    unsigned int type;
+    unsigned int offset;    // from the start of the file
+    unsigned int size;
+    unsigned int params[4];
+} ArchiveEntry;
+
+// A read-only mapping of a whole archive file
+typedef struct Archive {
+    const unsigned char *data;
+    size_t size;
+    const ArchiveEntry *entries;
+    int entryCount;
+    void *handle;           // platform mapping handle (Windows only)
+} Archive;
+
+// Entries are staged in memory and the file is written in one go by SaveArchive
+typedef struct ArchiveWriter {
+    ArchiveEntry entries[ARCHIVE_MAX_ENTRIES];
+    const void *payloads[ARCHIVE_MAX_ENTRIES];
+    int entryCount;
+} ArchiveWriter;
+
+// --- FUNCTION PROTOTYPES ---
+// Maps the file and checks its header and index; on failure the archive is left zeroed
+bool OpenArchive(Archive *archive, const char *fileName);
+void CloseArchive(Archive *archive);
+// NULL if there is no such entry
+const ArchiveEntry *FindArchiveEntry(const Archive *archive, const char *name);
+const void *ArchiveEntryData(const Archive *archive, const ArchiveEntry *entry);
+
+// The payload is not copied: it must stay valid until SaveArchive returns
+bool AddArchiveEntry(ArchiveWriter *writer, const char *name, ArchiveEntryType type,
+                     const unsigned int params[4], const void *data, unsigned int size);
+bool SaveArchive(const ArchiveWriter *writer, const char *fileName);
+
+#endif // ARCHIVE_H
@@ -0,0 +1,507 @@
+// src/assets.c
+#include "assets.h"
+#include "atlas.h"
+#include "game.h"
+#include <stdlib.h>
+#include <string.h>
+
+// --- FONT ---
+#define FONT_BASE_SIZE 64
+#define FONT_GLYPHS 95      // printable ASCII, the same set LoadFontEx picks by default
+#define FONT_GLYPH_PADDING 4
+
+// The shipped font has an upper-case extension; case-sensitive file systems need both
+static const char *const fontFiles[] = { "assets/font.ttf", "assets/font.TTF" };
+
+static const char *const spriteFiles[ATLAS_ENTRIES] = {
+    [ATLAS_BG]   = "assets/bg.png",
+    [ATLAS_PIPE] = "assets/pipe.png",
+    [ATLAS_BIRD] = "assets/bird.png"
+};
+
+static const char *const soundFiles[SOUND_COUNT] = {
+    [SOUND_FLAP]  = "assets/sounds/flap.wav",
+    [SOUND_SCORE] = "assets/sounds/score.wav",
+    [SOUND_HIT]   = "assets/sounds/hit.wav"
+};
+
+// --- HEARTS ---
+#define HEART_ROWS 14
+#define HEART_COLS 16
+
+// Pixel heart pattern (16x14 grid)
+// 1 = filled, 0 = empty
+static const unsigned char heartPattern[HEART_ROWS][HEART_COLS] = {
+    {0,0,1,1,1,0,0,0,0,0,1,1,1,0,0,0},
+    {0,1,1,1,1,1,0,0,0,1,1,1,1,1,0,0},
+    {1,1,1,1,1,1,1,0,1,1,1,1,1,1,1,0},
+    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
+    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
+    {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
+    {0,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0},
+    {0,0,1,1,1,1,1,1,1,1,1,1,1,0,0,0},
+    {0,0,0,1,1,1,1,1,1,1,1,1,0,0,0,0},
+    {0,0,0,0,1,1,1,1,1,1,1,0,0,0,0,0},
+    {0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0},
+    {0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0},
+    {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
+};
+
+// Rasterises the heart once, one texel per cell. Cells on the shape's edge take
+// the outline colour for that retro look; DrawLives scales it with point filtering.
+static Image BakeHeart(Color fill, Color outline) {
+    Image image = GenImageColor(HEART_COLS, HEART_ROWS, BLANK);
+
+    for (int row = 0; row < HEART_ROWS; row++) {
+        for (int col = 0; col < HEART_COLS; col++) {
+            if (!heartPattern[row][col]) continue;
+
+            bool isEdge = (row == 0 || !heartPattern[row - 1][col]) ||
+                          (row == HEART_ROWS - 1 || !heartPattern[row + 1][col]) ||
+                          (col == 0 || !heartPattern[row][col - 1]) ||
+                          (col == HEART_COLS - 1 || !heartPattern[row][col + 1]);
+
+            ImageDrawPixel(&image, col, row, isEdge ? outline : fill);
+        }
+    }
+
+    return image;
+}
+
+// --- ARCHIVE ENTRIES ---
+// Entry names; the glyph metrics are stored as four ints per glyph
+#define ENTRY_ATLAS       "atlas"
+#define ENTRY_REGIONS     "regions"
+#define ENTRY_GLYPHS      "font.glyphs"
+#define ENTRY_GLYPH_RECS  "font.recs"
+#define ENTRY_GLYPH_IMAGE "font.image"      // glyph cache only
+#define ENTRY_FONT_KEY    "font.key"        // glyph cache only
+#define ENTRY_SOURCES     "sources"         // size, time and hash of each loose file packed
+#define GLYPH_FIELDS      4     // value, offsetX, offsetY, advanceX
+
+static const char *const soundEntries[SOUND_COUNT] = {
+    [SOUND_FLAP] = "sound.flap", [SOUND_SCORE] = "sound.score", [SOUND_HIT] = "sound.hit"
+};
+
+static const ArchiveEntry missingEntry;
+
+// The named entry if it has the given type, else an empty stand-in
+static const ArchiveEntry *Entry(const Archive *archive, const char *name, ArchiveEntryType type) {
+    const ArchiveEntry *entry = FindArchiveEntry(archive, name);
+    return (entry != NULL && entry->type == type) ? entry : &missingEntry;
+}
+
+// Payload of an entry holding exactly `size` bytes, else NULL
+static const void *EntryData(const Archive *archive, const ArchiveEntry *entry, size_t size) {
+    if (entry == &missingEntry || size == 0 || entry->size != size) return NULL;
+    return ArchiveEntryData(archive, entry);
+}
+
+// GLYPH_FIELDS ints per glyph; the caller frees them once the archive is written
+static int *PackGlyphMetrics(const Font *font) {
+    int *metrics = malloc((size_t)font->glyphCount * GLYPH_FIELDS * sizeof(int));
+    if (metrics == NULL) return NULL;
+
+    for (int i = 0; i < font->glyphCount; i++) {
+        const GlyphInfo *g = &font->glyphs[i];
+        int *out = &metrics[i * GLYPH_FIELDS];
+        out[0] = g->value;
+        out[1] = g->offsetX;
+        out[2] = g->offsetY;
+        out[3] = g->advanceX;
+    }
+    return metrics;
+}
+
+static bool AddFontEntries(ArchiveWriter *writer, const Font *font, const int *metrics) {
+    unsigned int params[4] = { (unsigned int)font->baseSize, (unsigned int)font->glyphCount, (unsigned int)font->glyphPadding, 0 };
+
+    return AddArchiveEntry(writer, ENTRY_GLYPHS, ARCHIVE_RAW, params, metrics,
+                           (unsigned int)(font->glyphCount * GLYPH_FIELDS * sizeof(int))) &&
+           AddArchiveEntry(writer, ENTRY_GLYPH_RECS, ARCHIVE_RAW, params, font->recs,
+                           (unsigned int)(font->glyphCount * sizeof(Rectangle)));
+}
+
+// Glyph tables are small; they are copied so the font outlives the mapping
+static bool ReadFontEntries(const Archive *archive, Font *font) {
+    const ArchiveEntry *glyphEntry = Entry(archive, ENTRY_GLYPHS, ARCHIVE_RAW);
+    int glyphCount = (int)glyphEntry->params[1];
+    const int *metrics = EntryData(archive, glyphEntry, (size_t)glyphCount * GLYPH_FIELDS * sizeof(int));
+    const void *recs = EntryData(archive, Entry(archive, ENTRY_GLYPH_RECS, ARCHIVE_RAW), (size_t)glyphCount * sizeof(Rectangle));
+    if (metrics == NULL || recs == NULL) return false;
+
+    font->baseSize = (int)glyphEntry->params[0];
+    font->glyphCount = glyphCount;
+    font->glyphPadding = (int)glyphEntry->params[2];
+    font->recs = MemAlloc(glyphCount * sizeof(Rectangle));
+    font->glyphs = MemAlloc(glyphCount * sizeof(GlyphInfo));
+    memcpy(font->recs, recs, glyphCount * sizeof(Rectangle));
+    for (int i = 0; i < glyphCount; i++) {
+        const int *g = &metrics[i * GLYPH_FIELDS];
+        font->glyphs[i] = (GlyphInfo){ g[0], g[1], g[2], g[3], { 0 } };
+    }
+    return true;
+}
+
+// --- GLYPH CACHE ---
+// Rasterising font.ttf is the slow part of a loose-file start, so the glyph image and
+// metrics are kept in a small archive of their own. Its key entry holds a hash of the
+// font file and the raster settings; any mismatch is a miss and the cache is rewritten.
+#define FONT_CACHE_FILE "font.cache"
+
+// FNV-1a, 64-bit
+static unsigned long long HashBytes(const unsigned char *bytes, int size) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void FontCacheKey(unsigned int key[4], unsigned long long hash) {
+    key[0] = (unsigned int)hash;
+    key[1] = (unsigned int)(hash >> 32);
+    key[2] = FONT_BASE_SIZE;
+    key[3] = FONT_GLYPHS | (FONT_GLYPH_PADDING << 16);
+}
+
+static bool LoadCachedGlyphs(Font *font, Image *glyphAtlas, unsigned long long hash) {
+    Archive archive;
+    if (!OpenArchive(&archive, FONT_CACHE_FILE)) return false;
+
+    unsigned int key[4];
+    FontCacheKey(key, hash);
+    const void *cachedKey = EntryData(&archive, Entry(&archive, ENTRY_FONT_KEY, ARCHIVE_RAW), sizeof(key));
+    const ArchiveEntry *image = Entry(&archive, ENTRY_GLYPH_IMAGE, ARCHIVE_IMAGE);
+    int width = (int)image->params[0], height = (int)image->params[1], format = (int)image->params[2];
+    const void *pixels = EntryData(&archive, image, (size_t)GetPixelDataSize(width, height, format));
+
+    bool ok = cachedKey != NULL && memcmp(cachedKey, key, sizeof(key)) == 0 &&
+              pixels != NULL && ReadFontEntries(&archive, font);
+    if (ok) {
+        *glyphAtlas = (Image){ MemAlloc(image->size), width, height, 1, format };
+        memcpy(glyphAtlas->data, pixels, image->size);
+    }
+    CloseArchive(&archive);
+    return ok;
+}
+
+static bool SaveCachedGlyphs(const Font *font, const Image *glyphAtlas, unsigned long long hash) {
+    int *metrics = PackGlyphMetrics(font);
+    if (metrics == NULL) return false;
+
+    ArchiveWriter writer = { 0 };
+    unsigned int key[4];
+    FontCacheKey(key, hash);
+    unsigned int imageParams[4] = { (unsigned int)glyphAtlas->width, (unsigned int)glyphAtlas->height, (unsigned int)glyphAtlas->format, 0 };
+
+    bool ok = AddArchiveEntry(&writer, ENTRY_FONT_KEY, ARCHIVE_RAW, NULL, key, sizeof(key)) &&
+              AddArchiveEntry(&writer, ENTRY_GLYPH_IMAGE, ARCHIVE_IMAGE, imageParams, glyphAtlas->data,
+                              (unsigned int)GetPixelDataSize(glyphAtlas->width, glyphAtlas->height, glyphAtlas->format)) &&
+              AddFontEntries(&writer, font, metrics) &&
+              SaveArchive(&writer, FONT_CACHE_FILE);
+    free(metrics);
+    return ok;
+}
+
+// Rasterises the font on the CPU so its glyphs can be packed with the sprites, unless
+// the glyph cache already holds them for this exact file.
+// Returns false (and leaves the font zeroed) when the file is missing or unreadable.
+static bool LoadFontGlyphs(Font *font, Image *glyphAtlas, const char *path) {
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(path, &dataSize);
+    if (data == NULL) return false;
+
+    unsigned long long hash = HashBytes(data, dataSize);
+    if (LoadCachedGlyphs(font, glyphAtlas, hash)) {
+        UnloadFileData(data);
+        return true;
+    }
+
+    font->baseSize = FONT_BASE_SIZE;
+    font->glyphCount = FONT_GLYPHS;
+    font->glyphPadding = FONT_GLYPH_PADDING;
+    font->glyphs = LoadFontData(data, dataSize, font->baseSize, NULL, font->glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+
+    if (font->glyphs == NULL) {
+        *font = (Font){ 0 };
+        return false;
+    }
+
+    *glyphAtlas = GenImageFontAtlas(font->glyphs, &font->recs, font->glyphCount,
+                                    font->baseSize, font->glyphPadding, 0);
+
+    // The atlas holds the pixels now; only the metrics are kept per glyph
+    for (int i = 0; i < font->glyphCount; i++) {
+        UnloadImage(font->glyphs[i].image);
+        font->glyphs[i].image = (Image){ 0 };
+    }
+
+    if (!SaveCachedGlyphs(font, glyphAtlas, hash)) {
+        TraceLog(LOG_WARNING, "ASSETS: Failed to write %s", FONT_CACHE_FILE);
+    }
+    return true;
+}
+
+// --- BUILT-IN FONT ---
+// raylib's built-in font lives only on the GPU, so it is read back once on the main
+// thread; after that it can stand in for font.ttf and be packed from any thread.
+void LoadBuiltinGlyphs(GlyphSet *set) {
+    Font builtin = GetFontDefault();
+    Font *font = &set->font;
+
+    set->image = LoadImageFromTexture(builtin.texture);
+    *font = (Font){ 0 };
+    font->baseSize = builtin.baseSize;
+    font->glyphCount = builtin.glyphCount;
+    font->glyphPadding = builtin.glyphPadding;
+
+    font->recs = MemAlloc(builtin.glyphCount * sizeof(Rectangle));
+    font->glyphs = MemAlloc(builtin.glyphCount * sizeof(GlyphInfo));
+    memcpy(font->recs, builtin.recs, builtin.glyphCount * sizeof(Rectangle));
+    memcpy(font->glyphs, builtin.glyphs, builtin.glyphCount * sizeof(GlyphInfo));
+
+    // The copies must not share glyph images with raylib's own font
+    for (int i = 0; i < font->glyphCount; i++) font->glyphs[i].image = (Image){ 0 };
+}
+
+void UnloadGlyphSet(GlyphSet *set) {
+    if (set->font.glyphs != NULL) UnloadFontData(set->font.glyphs, set->font.glyphCount);
+    MemFree(set->font.recs);
+    UnloadImage(set->image);
+    memset(set, 0, sizeof(*set));
+}
+
+static void CopyGlyphSet(Font *font, Image *image, const GlyphSet *set) {
+    int count = set->font.glyphCount;
+    *font = set->font;
+    font->recs = MemAlloc(count * sizeof(Rectangle));
+    font->glyphs = MemAlloc(count * sizeof(GlyphInfo));
+    memcpy(font->recs, set->font.recs, count * sizeof(Rectangle));
+    memcpy(font->glyphs, set->font.glyphs, count * sizeof(GlyphInfo));
+    *image = ImageCopy(set->image);
+}
+
+// --- LOOSE FILES ---
+// Packs the entries into data->atlas, moves the glyph recs into atlas space and
+// releases the source images
+static void PackAssetAtlas(AssetData *data, Image *images) {
+    data->atlas = PackAtlas(images, ATLAS_ENTRIES, data->regions);
+    for (int i = 0; i < ATLAS_ENTRIES; i++) UnloadImage(images[i]);
+
+    for (int i = 0; i < data->font.glyphCount; i++) {
+        data->font.recs[i].x += data->regions[ATLAS_FONT].x;
+        data->font.recs[i].y += data->regions[ATLAS_FONT].y;
+    }
+}
+
+static void BakeHearts(Image *images) {
+    images[ATLAS_WHITE] = GenImageColor(4, 4, WHITE);
+    images[ATLAS_HEART_FULL]  = BakeHeart(RED, BLACK);
+    images[ATLAS_HEART_EMPTY] = BakeHeart((Color){ 100, 100, 100, 255 }, (Color){ 50, 50, 50, 255 });
+}
+
+bool DecodeAtlasFiles(AssetData *data, const GlyphSet *fallbackFont) {
+    Image images[ATLAS_ENTRIES] = { 0 };
+
+    bool haveFont = false;
+    for (int i = 0; i < (int)(sizeof(fontFiles) / sizeof(fontFiles[0])) && !haveFont; i++) {
+        haveFont = LoadFontGlyphs(&data->font, &images[ATLAS_FONT], fontFiles[i]);
+    }
+    if (!haveFont) {
+        if (fallbackFont == NULL) return false;
+        CopyGlyphSet(&data->font, &images[ATLAS_FONT], fallbackFont);
+    }
+
+    images[ATLAS_BG]    = LoadImage(spriteFiles[ATLAS_BG]);
+    images[ATLAS_PIPE]  = LoadImage(spriteFiles[ATLAS_PIPE]);
+    images[ATLAS_BIRD]  = LoadImage(spriteFiles[ATLAS_BIRD]);
+    BakeHearts(images);
+
+    PackAssetAtlas(data, images);
+    return true;
+}
+
+bool DecodeSoundFile(AssetData *data, SoundId sound) {
+    data->sounds[sound] = LoadWave(soundFiles[sound]);
+    return data->sounds[sound].data != NULL;
+}
+
+bool DecodeAssetFiles(AssetData *data, const GlyphSet *fallbackFont) {
+    memset(data, 0, sizeof(*data));
+    if (!DecodeAtlasFiles(data, fallbackFont)) return false;
+
+    for (int i = 0; i < SOUND_COUNT; i++) DecodeSoundFile(data, i);
+    return true;
+}
+
+// Flat-coloured stand-ins with the sprites' layout, shown until the real atlas is in
+void BuildPlaceholderAtlas(AssetData *data, const GlyphSet *font) {
+    memset(data, 0, sizeof(*data));
+    Image images[ATLAS_ENTRIES] = { 0 };
+
+    images[ATLAS_BG]   = GenImageColor(4, 4, SKYBLUE);
+    images[ATLAS_PIPE] = GenImageColor(PIPE_WIDTH, 2 * PIPE_CAP_HEIGHT, LIME);
+    ImageDrawRectangle(&images[ATLAS_PIPE], 0, 0, PIPE_WIDTH, PIPE_CAP_HEIGHT, DARKGREEN);
+    images[ATLAS_BIRD] = GenImageColor(4, 4, GOLD);
+    BakeHearts(images);
+    CopyGlyphSet(&data->font, &images[ATLAS_FONT], font);
+
+    PackAssetAtlas(data, images);
+}
+
+// --- SOURCE STAMPS ---
+// The archive keeps the size, modification time and hash of every loose file it was
+// packed from. If assets/ is there and any of them has changed since, the archive is
+// stale and the loose files win. Checking costs a stat per file; a file is only read
+// and hashed when its size matches but its time doesn't (a fresh checkout or a copy).
+// Files that are missing now are not compared, so an archive shipped without assets/
+// still loads.
+enum { SOURCE_FONT, SOURCE_BG, SOURCE_PIPE, SOURCE_BIRD, SOURCE_SOUNDS,
+       SOURCE_COUNT = SOURCE_SOUNDS + SOUND_COUNT };
+
+// Stored as-is in the sources entry (24 bytes, no padding)
+typedef struct SourceStamp {
+    long long size;                 // -1 if the file was missing
+    long long modTime;
+    unsigned long long hash;
+} SourceStamp;
+
+// The font is whichever candidate DecodeAtlasFiles would pick; NULL if none exists
+static const char *SourcePath(int source) {
+    if (source == SOURCE_FONT) {
+        for (int i = 0; i < (int)(sizeof(fontFiles) / sizeof(fontFiles[0])); i++) {
+            if (FileExists(fontFiles[i])) return fontFiles[i];
+        }
+        return NULL;
+    }
+    if (source >= SOURCE_SOUNDS) return soundFiles[source - SOURCE_SOUNDS];
+    static const int sprites[] = { [SOURCE_BG] = ATLAS_BG, [SOURCE_PIPE] = ATLAS_PIPE, [SOURCE_BIRD] = ATLAS_BIRD };
+    return spriteFiles[sprites[source]];
+}
+
+static unsigned long long HashFile(const char *path) {
+    int size = 0;
+    unsigned char *bytes = LoadFileData(path, &size);
+    if (bytes == NULL) return 0;
+    unsigned long long hash = HashBytes(bytes, size);
+    UnloadFileData(bytes);
+    return hash;
+}
+
+// Size and time only; the hash is filled in by the caller when it is needed
+static SourceStamp StatSource(int source) {
+    const char *path = SourcePath(source);
+    if (path == NULL || !FileExists(path)) return (SourceStamp){ -1, 0, 0 };
+    return (SourceStamp){ GetFileLength(path), (long long)GetFileModTime(path), 0 };
+}
+
+static bool SourceIsCurrent(int source, const SourceStamp *packed) {
+    SourceStamp now = StatSource(source);
+    if (now.size < 0) return true;
+    if (now.size != packed->size) return false;
+    if (now.modTime == packed->modTime) return true;
+    return HashFile(SourcePath(source)) == packed->hash;
+}
+
+// An archive without stamps predates them and counts as stale
+static bool ArchiveIsCurrent(const Archive *archive) {
+    const SourceStamp *packed = EntryData(archive, Entry(archive, ENTRY_SOURCES, ARCHIVE_RAW),
+                                          SOURCE_COUNT * sizeof(SourceStamp));
+    if (packed == NULL) return false;
+
+    for (int i = 0; i < SOURCE_COUNT; i++) {
+        if (!SourceIsCurrent(i, &packed[i])) return false;
+    }
+    return true;
+}
+
+// --- ARCHIVE ---
+bool LoadAssetArchive(AssetData *data, const char *fileName) {
+    memset(data, 0, sizeof(*data));
+    Archive *archive = &data->archive;
+    if (!OpenArchive(archive, fileName)) return false;
+    if (!ArchiveIsCurrent(archive)) {
+        TraceLog(LOG_INFO, "ASSETS: %s does not match assets/, using the loose files", fileName);
+        CloseArchive(archive);
+        return false;
+    }
+
+    // Atlas pixels are uploaded straight from the mapping
+    const ArchiveEntry *atlas = Entry(archive, ENTRY_ATLAS, ARCHIVE_IMAGE);
+    unsigned int width = atlas->params[0], height = atlas->params[1];
+    const void *pixels = EntryData(archive, atlas, (size_t)width * height * 4);
+    const void *regions = EntryData(archive, Entry(archive, ENTRY_REGIONS, ARCHIVE_RAW), sizeof(data->regions));
+
+    bool ok = pixels != NULL && atlas->params[2] == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 &&
+              regions != NULL && ReadFontEntries(archive, &data->font);
+
+    for (int i = 0; i < SOUND_COUNT && ok; i++) {
+        const ArchiveEntry *wave = Entry(archive, soundEntries[i], ARCHIVE_WAVE);
+        const unsigned int *p = wave->params;
+        const void *samples = EntryData(archive, wave, (size_t)p[0] * p[3] * (p[2] / 8));
+
+        ok = samples != NULL;
+        data->sounds[i] = (Wave){ p[0], p[1], p[2], p[3], (void *)samples };
+    }
+
+    if (!ok) {
+        UnloadAssetData(data);
+        return false;
+    }
+
+    data->atlas = (Image){ (void *)pixels, (int)width, (int)height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    memcpy(data->regions, regions, sizeof(data->regions));
+    return true;
+}
+
+bool SaveAssetArchive(const AssetData *data, const char *fileName) {
+    const Font *font = &data->font;
+    if (data->atlas.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || font->glyphs == NULL) return false;
+
+    int *metrics = PackGlyphMetrics(font);
+    if (metrics == NULL) return false;
+
+    ArchiveWriter writer = { 0 };
+    const Image *atlas = &data->atlas;
+    SourceStamp sources[SOURCE_COUNT];
+    for (int i = 0; i < SOURCE_COUNT; i++) {
+        sources[i] = StatSource(i);
+        if (sources[i].size >= 0) sources[i].hash = HashFile(SourcePath(i));
+    }
+    unsigned int atlasParams[4] = { (unsigned int)atlas->width, (unsigned int)atlas->height, (unsigned int)atlas->format, 0 };
+
+    bool ok = AddArchiveEntry(&writer, ENTRY_ATLAS, ARCHIVE_IMAGE, atlasParams, atlas->data,
+                              (unsigned int)atlas->width * atlas->height * 4);
+    ok = ok && AddArchiveEntry(&writer, ENTRY_REGIONS, ARCHIVE_RAW, NULL, data->regions, sizeof(data->regions));
+    ok = ok && AddFontEntries(&writer, font, metrics);
+    ok = ok && AddArchiveEntry(&writer, ENTRY_SOURCES, ARCHIVE_RAW, NULL, sources, sizeof(sources));
+
+    for (int i = 0; i < SOUND_COUNT && ok; i++) {
+        const Wave *wave = &data->sounds[i];
+        unsigned int params[4] = { wave->frameCount, wave->sampleRate, wave->sampleSize, wave->channels };
+        ok = wave->data != NULL &&
+             AddArchiveEntry(&writer, soundEntries[i], ARCHIVE_WAVE, params, wave->data,
+                             wave->frameCount * wave->channels * (wave->sampleSize / 8));
+    }
+
+    ok = ok && SaveArchive(&writer, fileName);
+    free(metrics);
+    return ok;
+}
+
+void UnloadAssetData(AssetData *data) {
+    // Pixels and samples from the archive belong to the mapping
+    if (data->archive.data == NULL) {
+        UnloadImage(data->atlas);
+        for (int i = 0; i < SOUND_COUNT; i++) UnloadWave(data->sounds[i]);
+    }
+    CloseArchive(&data->archive);
+
+    if (data->font.glyphs != NULL) UnloadFontData(data->font.glyphs, data->font.glyphCount);
+    MemFree(data->font.recs);
+    memset(data, 0, sizeof(*data));
+}
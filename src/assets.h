@@ -0,0 +1,65 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "archive.h"
+
+// --- ASSET FILES ---
+#define ASSET_ARCHIVE "assets.pak"      // written by tools/pack.c; loose files are the fallback
+#define PIPE_CAP_HEIGHT 24              // rows at the top of pipe.png that form the cap
+
+// Atlas regions, in the order they are packed
+enum {
+    ATLAS_BG, ATLAS_PIPE, ATLAS_BIRD, ATLAS_WHITE,
+    ATLAS_HEART_FULL, ATLAS_HEART_EMPTY, ATLAS_FONT, ATLAS_ENTRIES
+};
+
+typedef enum SoundId {
+    SOUND_FLAP, SOUND_SCORE, SOUND_HIT, SOUND_COUNT
+} SoundId;
+
+// --- STRUCTURES ---
+// A font's metrics with all of its glyphs in one image
+typedef struct GlyphSet {
+    Font font;              // recs relative to image; no texture
+    Image image;
+} GlyphSet;
+
+// Everything the game needs, decoded in CPU memory and ready to hand to the GPU and
+// audio device. Loaded from the archive, the atlas pixels and samples point straight
+// into its mapping; loaded from loose files, they are decoded into owned buffers.
+typedef struct AssetData {
+    Image atlas;                        // RGBA8: every sprite and the font glyphs
+    Rectangle regions[ATLAS_ENTRIES];
+    Font font;                          // glyph metrics, recs in atlas space; no texture or glyph images
+    Wave sounds[SOUND_COUNT];
+    Archive archive;                    // open while the data points into it
+} AssetData;
+
+// --- FUNCTION PROTOTYPES ---
+// Everything but LoadBuiltinGlyphs is CPU-only and safe to run off the main thread.
+
+// False (with data zeroed) if the archive is missing or damaged, or stale: a file in
+// assets/ no longer matches the size and contents recorded when it was packed
+bool LoadAssetArchive(AssetData *data, const char *fileName);
+// Records the loose files as they are now, so pack right after decoding them
+bool SaveAssetArchive(const AssetData *data, const char *fileName);
+
+// Loose files. The atlas fails if font.ttf can't be loaded and there is no fallback font.
+// DecodeAssetFiles zeroes data and does both steps; the others fill in only their part.
+bool DecodeAssetFiles(AssetData *data, const GlyphSet *fallbackFont);
+bool DecodeAtlasFiles(AssetData *data, const GlyphSet *fallbackFont);
+bool DecodeSoundFile(AssetData *data, SoundId sound);
+
+// Solid-colour sprites with the real layout plus the given font, for drawing before loading ends
+void BuildPlaceholderAtlas(AssetData *data, const GlyphSet *font);
+
+// raylib's built-in font as CPU data; main thread only (reads the font texture back)
+void LoadBuiltinGlyphs(GlyphSet *set);
+void UnloadGlyphSet(GlyphSet *set);
+
+// Releases whatever is left; zero font.glyphs/font.recs first to keep them
+void UnloadAssetData(AssetData *data);
+
+#endif // ASSETS_H
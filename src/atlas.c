@@ -0,0 +1,65 @@
+// src/atlas.c
+#include "atlas.h"
+#include <stddef.h>
+
+#define ATLAS_MAX_ENTRIES 32
+
+// --- PACKING ---
+Image PackAtlas(const Image *images, int count, Rectangle *regions) {
+    int order[ATLAS_MAX_ENTRIES];
+    if (count > ATLAS_MAX_ENTRIES) count = ATLAS_MAX_ENTRIES;
+
+    // Tallest first keeps shelves tight; insertion sort is plenty for a handful of images
+    for (int i = 0; i < count; i++) {
+        int j = i;
+        while (j > 0 && images[order[j - 1]].height < images[i].height) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    int x = 0, y = 0, shelfHeight = 0;
+    int width = 0, height = 0;
+
+    for (int k = 0; k < count; k++) {
+        int i = order[k];
+        regions[i] = (Rectangle){ 0, 0, 0, 0 };
+        if (images[i].data == NULL) continue;
+
+        int w = images[i].width + ATLAS_PADDING;
+        int h = images[i].height + ATLAS_PADDING;
+
+        if (x > 0 && x + w > ATLAS_MAX_WIDTH) {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        regions[i] = (Rectangle){
+            (float)(x + ATLAS_PADDING), (float)(y + ATLAS_PADDING),
+            (float)images[i].width, (float)images[i].height
+        };
+
+        x += w;
+        if (h > shelfHeight) shelfHeight = h;
+        if (x + ATLAS_PADDING > width) width = x + ATLAS_PADDING;
+        if (y + shelfHeight + ATLAS_PADDING > height) height = y + shelfHeight + ATLAS_PADDING;
+    }
+
+    if (width == 0 || height == 0) return (Image){ 0 };
+
+    Image atlas = GenImageColor(width, height, BLANK);
+    for (int i = 0; i < count; i++) {
+        if (images[i].data == NULL) continue;
+
+        Rectangle src = { 0, 0, (float)images[i].width, (float)images[i].height };
+        ImageDraw(&atlas, images[i], src, regions[i], WHITE);
+    }
+
+    return atlas;
+}
+
+Rectangle AtlasRect(Rectangle region, float x, float y, float width, float height) {
+    return (Rectangle){ region.x + x, region.y + y, width, height };
+}
@@ -0,0 +1,22 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// --- ATLAS PACKING ---
+// Shelves wrap at this width; a single image wider than it gets a shelf of its own
+#define ATLAS_MAX_WIDTH 2048
+// Empty texels around every entry so neighbouring sprites never bleed into each other
+#define ATLAS_PADDING 2
+
+// --- FUNCTION PROTOTYPES ---
+// Packs `count` images into one RGBA image, tallest first on horizontal shelves.
+// regions[i] receives where images[i] landed; images without pixel data get an empty region.
+Image PackAtlas(const Image *images, int count, Rectangle *regions);
+
+// A rectangle given relative to a packed image, moved into atlas space
+// (negative width/height, for flipped sources, are preserved)
+Rectangle AtlasRect(Rectangle region, float x, float y, float width, float height);
+
+#endif // ATLAS_H
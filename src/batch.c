@@ -0,0 +1,497 @@
+// src/batch.c
+#include "batch.h"
+#include "player.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PIPE_INACTIVE_X -1.0e6f
+
+// --- SIMD ABSTRACTION ---
+// The step kernel is written once against these macros. Build with -mavx2
+// (or -march=native) for 8 lanes; plain x86-64 gets SSE2; others run scalar.
+// With -ffp-contract=off (see game.h), every width rounds exactly like Game.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define BATCH_LANES 8
+    #define BATCH_KERNEL "avx2"
+    typedef __m256  VecF;
+    typedef __m256i VecI;
+    #define VLoadF(p)        _mm256_loadu_ps(p)
+    #define VStoreF(p, v)    _mm256_storeu_ps(p, v)
+    #define VLoadI(p)        _mm256_loadu_si256((const __m256i *)(p))
+    #define VStoreI(p, v)    _mm256_storeu_si256((__m256i *)(p), v)
+    #define VSet(x)          _mm256_set1_ps(x)
+    #define VZeroI()         _mm256_setzero_si256()
+    #define VAdd(a, b)       _mm256_add_ps(a, b)
+    #define VSub(a, b)       _mm256_sub_ps(a, b)
+    #define VMul(a, b)       _mm256_mul_ps(a, b)
+    #define VDiv(a, b)       _mm256_div_ps(a, b)
+    #define VMin(a, b)       _mm256_min_ps(a, b)
+    #define VLt(a, b)        _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+    #define VLe(a, b)        _mm256_cmp_ps(a, b, _CMP_LE_OQ)
+    #define VGt(a, b)        _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+    #define VGe(a, b)        _mm256_cmp_ps(a, b, _CMP_GE_OQ)
+    #define VEq(a, b)        _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+    #define VAnd(a, b)       _mm256_and_ps(a, b)
+    #define VOr(a, b)        _mm256_or_ps(a, b)
+    #define VAndNot(a, b)    _mm256_andnot_ps(a, b)
+    #define VSelect(m, a, b) _mm256_blendv_ps(b, a, m)
+    #define VEqI(a, b)       _mm256_cmpeq_epi32(a, b)
+    #define VSubI(a, b)      _mm256_sub_epi32(a, b)
+    #define VAsF(v)          _mm256_castsi256_ps(v)
+    #define VAsI(v)          _mm256_castps_si256(v)
+    #define VMask(v)         _mm256_movemask_ps(v)
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define BATCH_LANES 4
+    #define BATCH_KERNEL "sse2"
+    typedef __m128  VecF;
+    typedef __m128i VecI;
+    #define VLoadF(p)        _mm_loadu_ps(p)
+    #define VStoreF(p, v)    _mm_storeu_ps(p, v)
+    #define VLoadI(p)        _mm_loadu_si128((const __m128i *)(p))
+    #define VStoreI(p, v)    _mm_storeu_si128((__m128i *)(p), v)
+    #define VSet(x)          _mm_set1_ps(x)
+    #define VZeroI()         _mm_setzero_si128()
+    #define VAdd(a, b)       _mm_add_ps(a, b)
+    #define VSub(a, b)       _mm_sub_ps(a, b)
+    #define VMul(a, b)       _mm_mul_ps(a, b)
+    #define VDiv(a, b)       _mm_div_ps(a, b)
+    #define VMin(a, b)       _mm_min_ps(a, b)
+    #define VLt(a, b)        _mm_cmplt_ps(a, b)
+    #define VLe(a, b)        _mm_cmple_ps(a, b)
+    #define VGt(a, b)        _mm_cmpgt_ps(a, b)
+    #define VGe(a, b)        _mm_cmpge_ps(a, b)
+    #define VEq(a, b)        _mm_cmpeq_ps(a, b)
+    #define VAnd(a, b)       _mm_and_ps(a, b)
+    #define VOr(a, b)        _mm_or_ps(a, b)
+    #define VAndNot(a, b)    _mm_andnot_ps(a, b)
+    #define VSelect(m, a, b) _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+    #define VEqI(a, b)       _mm_cmpeq_epi32(a, b)
+    #define VSubI(a, b)      _mm_sub_epi32(a, b)
+    #define VAsF(v)          _mm_castsi128_ps(v)
+    #define VAsI(v)          _mm_castps_si128(v)
+    #define VMask(v)         _mm_movemask_ps(v)
+#else
+    #define BATCH_LANES 1
+    #define BATCH_KERNEL "scalar"
+#endif
+
+const char *BatchKernelName(void) {
+    return BATCH_KERNEL;
+}
+
+// --- LIFECYCLE ---
+bool InitBatch(BatchWorlds *batch, int count, unsigned int seed) {
+    memset(batch, 0, sizeof(*batch));
+    if (count <= 0) return false;
+
+    // The extra cache line stops arrays landing a power of two apart, where
+    // a tile's ~25 streams would all compete for the same L1 sets
+    int stride = (count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES + 16;
+    int perWorld = 9 + 4 * BATCH_PIPE_SLOTS;   // 4-byte fields per world
+
+    // One block keeps every array adjacent; padding lanes stay zero (dead)
+    char *block = calloc((size_t)stride * perWorld, 4);
+    if (block == NULL) return false;
+
+    size_t lane = (size_t)stride * 4;
+    size_t pipes = lane * BATCH_PIPE_SLOTS;
+    batch->birdY      = (float *)block;         block += lane;
+    batch->birdVel    = (float *)block;         block += lane;
+    batch->alive      = (int *)block;           block += lane;
+    batch->score      = (int *)block;           block += lane;
+    batch->ticks      = (int *)block;           block += lane;
+    batch->flap       = (int *)block;           block += lane;
+    batch->spawnTimer = (float *)block;         block += lane;
+    batch->nextSlot   = (int *)block;           block += lane;
+    batch->rng        = (unsigned int *)block;  block += lane;
+    batch->pipeX      = (float *)block;         block += pipes;
+    batch->gapTop     = (float *)block;         block += pipes;
+    batch->gapBottom  = (float *)block;         block += pipes;
+    batch->pipeScored = (int *)block;
+
+    batch->count = count;
+    batch->stride = stride;
+
+    for (int w = 0; w < count; w++) {
+        ResetBatchWorld(batch, w, seed + (unsigned int)w);
+    }
+    return true;
+}
+
+void FreeBatch(BatchWorlds *batch) {
+    free(batch->birdY);   // start of the shared block
+    memset(batch, 0, sizeof(*batch));
+}
+
+// Same draws in the same order as SpawnPipe, so a world and a Game reset
+// with the same seed see the same course
+static void SpawnBatchPipe(BatchWorlds *batch, int w) {
+    int slot = batch->nextSlot[w];
+    batch->nextSlot[w] = (slot + 1) % BATCH_PIPE_SLOTS;
+
+    int gapSize = RandomRange(&batch->rng[w], MIN_GAP_SIZE, MAX_GAP_SIZE);
+    int minY = 60;
+    int maxY = SCREEN_HEIGHT - 60 - gapSize;
+    int gapY = RandomRange(&batch->rng[w], minY, maxY);
+
+    int i = slot * batch->stride + w;
+    batch->pipeX[i] = (float)SCREEN_WIDTH;
+    batch->gapTop[i] = (float)gapY;
+    batch->gapBottom[i] = (float)(gapY + gapSize);
+    batch->pipeScored[i] = 0;
+}
+
+void ResetBatchWorld(BatchWorlds *batch, int w, unsigned int seed) {
+    batch->birdY[w] = SCREEN_HEIGHT / 2.0f;
+    batch->birdVel[w] = 0.0f;
+    batch->alive[w] = -1;
+    batch->score[w] = 0;
+    batch->ticks[w] = 0;
+    batch->flap[w] = 0;
+    batch->spawnTimer[w] = 0.0f;
+    batch->nextSlot[w] = 0;
+    batch->rng[w] = SeedRandom(seed);
+
+    for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+        int i = s * batch->stride + w;
+        batch->pipeX[i] = PIPE_INACTIVE_X;
+        batch->pipeScored[i] = -1;
+    }
+
+    SpawnBatchPipe(batch, w);
+}
+
+// --- STEP ---
+static int CountBits(int mask) {
+    int n = 0;
+    for (; mask; mask &= mask - 1) n++;
+    return n;
+}
+
+// Reference kernel, mirrors the RUNNING branch of UpdateGame for one life:
+// swept bounds and pipes, and scoring only for pipes passed before the impact.
+static bool StepWorldScalar(BatchWorlds *batch, int w, float dt) {
+    const float halfH = BIRD_HEIGHT * 0.5f;
+    const float birdLeft = 100.0f - BIRD_WIDTH * 0.5f;
+    const float birdRight = 100.0f + BIRD_WIDTH * 0.5f;
+    const float scroll = PIPE_SPEED * dt;
+
+    if (!batch->alive[w]) return false;
+
+    float y0 = batch->birdY[w];
+    float vel = batch->flap[w] ? FLAP_STRENGTH : batch->birdVel[w];
+    vel += GRAVITY * dt;
+    if (vel > MAX_FALL_SPEED) vel = MAX_FALL_SPEED;
+    float travel = vel * dt;
+    float y = y0 + travel;
+    if (y - halfH < 0.0f) {
+        y = halfH;
+        vel = 0.0f;
+    }
+    batch->birdY[w] = y;
+    batch->birdVel[w] = vel;
+    batch->ticks[w]++;
+
+    float top = y - halfH;
+    float bottom = y + halfH;
+    float impact = 2.0f;
+
+    // Bounds (BirdSweepWorld)
+    if ((bottom >= SCREEN_HEIGHT) || (top <= 0.0f)) {
+        float t = 1.0f;
+        if (travel < 0.0f) {
+            t = (y0 - halfH) / -travel;
+        } else if (travel > 0.0f) {
+            t = ((float)SCREEN_HEIGHT - (y0 + halfH)) / travel;
+        }
+        impact = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+    }
+
+    // Pipes (SweepPipe), in each pipe's start-of-step frame
+    Rectangle from = { birdLeft, y0 - halfH, BIRD_WIDTH, BIRD_HEIGHT };
+    Vector2 motion = { scroll, y - y0 };
+
+    for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+        int i = s * batch->stride + w;
+        float x0 = batch->pipeX[i];
+        float x = x0 - scroll;
+        float gapTop = batch->gapTop[i];
+        float gapBottom = batch->gapBottom[i];
+
+        float tTop = 2.0f, tBottom = 2.0f;
+        SweepRects(from, motion, (Rectangle){ x0, 0.0f, PIPE_WIDTH, gapTop }, &tTop);
+        SweepRects(from, motion, (Rectangle){ x0, gapBottom, PIPE_WIDTH, SCREEN_HEIGHT - gapBottom }, &tBottom);
+
+        bool overlapX = birdLeft < x + PIPE_WIDTH && birdRight > x;
+        if (overlapX && top < gapTop && tTop > 1.0f) tTop = 1.0f;
+        if (overlapX && bottom > gapBottom && tBottom > 1.0f) tBottom = 1.0f;
+
+        if (tTop < impact) impact = tTop;
+        if (tBottom < impact) impact = tBottom;
+    }
+
+    for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+        int i = s * batch->stride + w;
+        float x0 = batch->pipeX[i];
+        if (!batch->pipeScored[i] && birdLeft > x0 - scroll + PIPE_WIDTH * 0.5f &&
+            x0 + PIPE_WIDTH * 0.5f - birdLeft < impact * scroll) {
+            batch->pipeScored[i] = -1;
+            batch->score[w]++;
+        }
+    }
+
+    if (impact <= 1.0f) {
+        batch->alive[w] = 0;
+        return true;
+    }
+
+    for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+        batch->pipeX[s * batch->stride + w] -= scroll;
+    }
+
+    batch->spawnTimer[w] += dt;
+    if (batch->spawnTimer[w] >= PIPE_SPAWN_TIME) {
+        batch->spawnTimer[w] = 0.0f;
+        SpawnBatchPipe(batch, w);
+    }
+    return false;
+}
+
+int StepBatchScalar(BatchWorlds *batch, float dt) {
+    int died = 0;
+    for (int w = 0; w < batch->count; w++) {
+        if (StepWorldScalar(batch, w, dt)) died++;
+    }
+    return died;
+}
+
+#if BATCH_LANES > 1
+// SweepRects' y axis for every lane against one pipe half, continuing from the x axis
+// interval [enterX, exitX]. Returns the time of impact, or 2 where the bird misses it.
+static VecF SweepHalf(VecF enterX, VecF exitX, VecF aMin, VecF aMax, VecF invDy, VecF dyZero, VecF dyNeg,
+                      VecF bMin, VecF bMax) {
+    VecF t0 = VMul(VSub(bMin, aMax), invDy);
+    VecF t1 = VMul(VSub(bMax, aMin), invDy);
+    VecF first = VSelect(dyNeg, t1, t0);
+    VecF last = VSelect(dyNeg, t0, t1);
+
+    VecF enter = VSelect(VGt(first, enterX), first, enterX);
+    VecF exit = VSelect(VLt(last, exitX), last, exitX);
+    VecF moving = VLt(enter, exit);
+
+    // Not moving vertically: overlapping for the whole step or never
+    VecF still = VAnd(VAnd(VLt(aMin, bMax), VGt(aMax, bMin)), VLt(enterX, exitX));
+
+    VecF hit = VSelect(dyZero, still, moving);
+    enter = VSelect(dyZero, enterX, enter);
+    return VSelect(hit, enter, VSet(2.0f));
+}
+#endif
+
+int StepBatch(BatchWorlds *batch, float dt) {
+    return StepBatchRange(batch, 0, batch->count, dt);
+}
+
+// Step worlds [first, first + count). Running a cache-sized range for many
+// ticks before moving on keeps the working set in L1/L2 (see BATCH_TILE).
+int StepBatchRange(BatchWorlds *batch, int first, int count, float dt) {
+#if BATCH_LANES == 1
+    int died = 0;
+    for (int w = first; w < first + count && w < batch->count; w++) {
+        if (StepWorldScalar(batch, w, dt)) died++;
+    }
+    return died;
+#else
+    const int stride = batch->stride;
+    const int start = first / BATCH_LANES * BATCH_LANES;
+    const int end = (first + count < stride) ? first + count : stride;
+    const VecF zero = VSet(0.0f);
+    const VecF halfH = VSet(BIRD_HEIGHT * 0.5f);
+    const VecF screenH = VSet((float)SCREEN_HEIGHT);
+    const VecF flapVel = VSet(FLAP_STRENGTH);
+    const VecF gravityDt = VSet(GRAVITY * dt);
+    const VecF maxFall = VSet(MAX_FALL_SPEED);
+    const VecF vdt = VSet(dt);
+    const VecF scroll = VSet(PIPE_SPEED * dt);
+    const VecF pipeW = VSet((float)PIPE_WIDTH);
+    const VecF pipeHalfW = VSet(PIPE_WIDTH * 0.5f);
+    const VecF birdLeft = VSet(100.0f - BIRD_WIDTH * 0.5f);
+    const VecF birdRight = VSet(100.0f + BIRD_WIDTH * 0.5f);
+    const VecF birdH = VSet((float)BIRD_HEIGHT);
+    const VecF spawnTime = VSet(PIPE_SPAWN_TIME);
+    const VecF one = VSet(1.0f);
+    const VecF two = VSet(2.0f);
+    const VecF invScroll = VSet(1.0f / (PIPE_SPEED * dt));
+    // Generous x window for the per-slot skip; the sweep itself decides
+    const VecF nearLeft = VSet(100.0f - BIRD_WIDTH * 0.5f - 1.0f);
+    const VecF nearRight = VSet(100.0f + BIRD_WIDTH * 0.5f + PIPE_SPEED * dt + 1.0f);
+
+    int died = 0;
+
+    for (int i = start; i < end; i += BATCH_LANES) {
+        VecF alive = VAsF(VLoadI(batch->alive + i));
+        if (VMask(alive) == 0) continue;
+
+        // Bird: flap, gravity, clamp, ceiling (UpdateBird)
+        VecF noFlap = VAsF(VEqI(VLoadI(batch->flap + i), VZeroI()));
+        VecF y0 = VLoadF(batch->birdY + i);
+        VecF vel0 = VLoadF(batch->birdVel + i);
+
+        VecF vel = VSelect(noFlap, vel0, flapVel);
+        vel = VMin(VAdd(vel, gravityDt), maxFall);
+        VecF travel = VMul(vel, vdt);
+        VecF y = VAdd(y0, travel);
+        VecF ceiling = VLt(VSub(y, halfH), zero);
+        y = VSelect(ceiling, halfH, y);
+        vel = VSelect(ceiling, zero, vel);
+
+        // Bounds (BirdSweepWorld): time of impact from the unclamped travel
+        VecF top = VSub(y, halfH);
+        VecF bottom = VAdd(y, halfH);
+        VecF hitWorld = VAnd(VOr(VGe(bottom, screenH), VLe(top, zero)), alive);
+        VecF impact = two;
+
+        if (VMask(hitWorld)) {
+            VecF tWorld = VSelect(VLt(travel, zero), VDiv(VSub(y0, halfH), VSub(zero, travel)),
+                          VSelect(VGt(travel, zero), VDiv(VSub(screenH, VAdd(y0, halfH)), travel), one));
+            tWorld = VSelect(VLt(tWorld, zero), zero, VSelect(VGt(tWorld, one), one, tWorld));
+            impact = VSelect(hitWorld, tWorld, two);
+        }
+
+        // Pipes (SweepPipe): same slab arithmetic as SweepRects, x shared by both halves
+        VecF fromTop = VSub(y0, halfH);
+        VecF fromBottom = VAdd(fromTop, birdH);
+        VecF dy = VSub(y, y0);
+        VecF dyZero = VEq(dy, zero);
+        VecF dyNeg = VLt(dy, zero);
+        VecF invDy = VDiv(one, dy);     // inf where dy == 0; those lanes take the still path
+
+        for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+            int p = s * stride + i;
+            VecF x0 = VLoadF(batch->pipeX + p);
+
+            // Most slots are nowhere near the bird; skip them unless some lane could touch
+            VecF near = VAnd(VLt(x0, nearRight), VGt(VAdd(x0, pipeW), nearLeft));
+            if (VMask(VAnd(near, alive)) == 0) continue;
+
+            VecF x = VSub(x0, scroll);
+            VecF gapTop = VLoadF(batch->gapTop + p);
+            VecF gapBottom = VLoadF(batch->gapBottom + p);
+
+            VecF t0 = VMul(VSub(x0, birdRight), invScroll);
+            VecF t1 = VMul(VSub(VAdd(x0, pipeW), birdLeft), invScroll);
+            VecF enterX = VSelect(VGt(t0, zero), t0, zero);
+            VecF exitX = VSelect(VLt(t1, one), t1, one);
+
+            VecF tTop = SweepHalf(enterX, exitX, fromTop, fromBottom, invDy, dyZero, dyNeg,
+                                  zero, VAdd(zero, gapTop));
+            VecF tBottom = SweepHalf(enterX, exitX, fromTop, fromBottom, invDy, dyZero, dyNeg,
+                                     gapBottom, VAdd(gapBottom, VSub(screenH, gapBottom)));
+
+            VecF overlapX = VAnd(VLt(birdLeft, VAdd(x, pipeW)), VGt(birdRight, x));
+            tTop = VSelect(VAnd(VAnd(overlapX, VLt(top, gapTop)), VGt(tTop, one)), one, tTop);
+            tBottom = VSelect(VAnd(VAnd(overlapX, VGt(bottom, gapBottom)), VGt(tBottom, one)), one, tBottom);
+
+            impact = VSelect(VLt(tTop, impact), tTop, impact);
+            impact = VSelect(VLt(tBottom, impact), tBottom, impact);
+        }
+
+        VecF hit = VAnd(VLe(impact, one), alive);
+        VecF survived = VAndNot(hit, alive);
+        VecF impactScroll = VMul(impact, scroll);
+
+        // Score pipes passed before any impact; only survivors scroll on
+        VecI score = VLoadI(batch->score + i);
+        for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+            int p = s * stride + i;
+            VecF x0 = VLoadF(batch->pipeX + p);
+            VecF scored = VAsF(VLoadI(batch->pipeScored + p));
+            VecF passed = VAnd(VGt(birdLeft, VAdd(VSub(x0, scroll), pipeHalfW)),
+                               VLt(VSub(VAdd(x0, pipeHalfW), birdLeft), impactScroll));
+            VecF gained = VAnd(VAndNot(scored, passed), alive);
+
+            VStoreI(batch->pipeScored + p, VAsI(VOr(scored, gained)));
+            VStoreF(batch->pipeX + p, VSelect(survived, VSub(x0, scroll), x0));
+            score = VSubI(score, VAsI(gained));
+        }
+        VStoreI(batch->score + i, score);
+
+        // Dead lanes keep their final state
+        VStoreF(batch->birdY + i, VSelect(alive, y, y0));
+        VStoreF(batch->birdVel + i, VSelect(alive, vel, vel0));
+        VStoreI(batch->alive + i, VAsI(survived));
+        VStoreI(batch->ticks + i, VSubI(VLoadI(batch->ticks + i), VAsI(alive)));
+
+        VecF timer0 = VLoadF(batch->spawnTimer + i);
+        VecF timer = VSelect(survived, VAdd(timer0, vdt), timer0);
+        VStoreF(batch->spawnTimer + i, timer);
+
+        // Spawns are rare (one per PIPE_SPAWN_TIME), so they stay scalar
+        for (int due = VMask(VAnd(survived, VGe(timer, spawnTime))); due; due &= due - 1) {
+            int w = i + CountBits((due & -due) - 1);
+            batch->spawnTimer[w] = 0.0f;
+            SpawnBatchPipe(batch, w);
+        }
+
+        died += CountBits(VMask(hit));
+    }
+
+    return died;
+#endif
+}
+
+// --- AUTOPILOT ---
+// Same policy as the headless tool: flap when below the middle of the next gap
+void BatchAutopilot(BatchWorlds *batch) {
+    BatchAutopilotRange(batch, 0, batch->count);
+}
+
+void BatchAutopilotRange(BatchWorlds *batch, int first, int count) {
+#if BATCH_LANES == 1
+    const float birdLeft = 100.0f - BIRD_WIDTH * 0.5f;
+
+    for (int w = first; w < first + count && w < batch->count; w++) {
+        float nextX = 1.0e9f;
+        float targetY = SCREEN_HEIGHT / 2.0f;
+
+        for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+            int i = s * batch->stride + w;
+            float x = batch->pipeX[i];
+            if (x + PIPE_WIDTH < birdLeft || x >= nextX) continue;
+            nextX = x;
+            targetY = (batch->gapTop[i] + batch->gapBottom[i]) * 0.5f;
+        }
+
+        batch->flap[w] = batch->alive[w] && batch->birdY[w] > targetY + 10.0f && batch->birdVel[w] > 0.0f;
+    }
+#else
+    const int stride = batch->stride;
+    const int start = first / BATCH_LANES * BATCH_LANES;
+    const int end = (first + count < stride) ? first + count : stride;
+    const VecF birdLeft = VSet(100.0f - BIRD_WIDTH * 0.5f);
+    const VecF pipeW = VSet((float)PIPE_WIDTH);
+    const VecF half = VSet(0.5f);
+    const VecF margin = VSet(10.0f);
+    const VecF zero = VSet(0.0f);
+
+    for (int i = start; i < end; i += BATCH_LANES) {
+        VecF nextX = VSet(1.0e9f);
+        VecF targetY = VSet(SCREEN_HEIGHT / 2.0f);
+
+        for (int s = 0; s < BATCH_PIPE_SLOTS; s++) {
+            int p = s * stride + i;
+            VecF x = VLoadF(batch->pipeX + p);
+            VecF ahead = VAnd(VGe(VAdd(x, pipeW), birdLeft), VLt(x, nextX));
+            VecF gapMid = VMul(VAdd(VLoadF(batch->gapTop + p), VLoadF(batch->gapBottom + p)), half);
+            nextX = VSelect(ahead, x, nextX);
+            targetY = VSelect(ahead, gapMid, targetY);
+        }
+
+        VecF flap = VAnd(VGt(VLoadF(batch->birdY + i), VAdd(targetY, margin)),
+                         VGt(VLoadF(batch->birdVel + i), zero));
+        VStoreI(batch->flap + i, VAsI(VAnd(flap, VAsF(VLoadI(batch->alive + i)))));
+    }
+#endif
+}
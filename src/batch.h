@@ -0,0 +1,54 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdbool.h>
+#include "game.h"
+
+// --- BATCH CONSTANTS ---
+// A pipe lives (SCREEN_WIDTH + PIPE_WIDTH) / PIPE_SPEED ~ 5.9 s and one spawns
+// every PIPE_SPAWN_TIME, so 4 ring slots per world never overwrite a live pipe.
+#define BATCH_PIPE_SLOTS 4
+
+// Worlds per cache-resident tile (~25 KB of state) for StepBatchRange loops
+#define BATCH_TILE       256
+
+// --- STRUCTURES ---
+// Many independent single-life runs stepped in lockstep. Every field is a
+// contiguous array indexed by world (pipe arrays by slot * stride + world),
+// so the step kernel streams through memory with SIMD loads.
+// Masks (alive, pipeScored) hold 0 or -1 so they can be used as lane masks.
+typedef struct BatchWorlds {
+    int count;              // worlds in use
+    int stride;             // array pitch: count rounded up to whole vectors, plus padding
+
+    float *birdY;
+    float *birdVel;
+    int *alive;
+    int *score;
+    int *ticks;             // ticks survived in the current run
+    int *flap;              // input for the next StepBatch, non-zero = flap
+
+    float *pipeX;           // [slot * stride + world]
+    float *gapTop;          // bottom edge of the top pipe
+    float *gapBottom;       // top edge of the bottom pipe
+    int *pipeScored;
+
+    float *spawnTimer;
+    int *nextSlot;
+    unsigned int *rng;
+} BatchWorlds;
+
+// --- FUNCTION PROTOTYPES ---
+bool InitBatch(BatchWorlds *batch, int count, unsigned int seed);
+void FreeBatch(BatchWorlds *batch);
+void ResetBatchWorld(BatchWorlds *batch, int world, unsigned int seed);
+
+// Advances every live world one tick using batch->flap; returns how many died
+int StepBatch(BatchWorlds *batch, float dt);
+int StepBatchRange(BatchWorlds *batch, int first, int count, float dt);
+int StepBatchScalar(BatchWorlds *batch, float dt);
+void BatchAutopilot(BatchWorlds *batch);
+void BatchAutopilotRange(BatchWorlds *batch, int first, int count);
+const char *BatchKernelName(void);
+
+#endif // BATCH_H
\ No newline at end of file
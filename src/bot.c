@@ -0,0 +1,36 @@
+// src/bot.c
+#include "bot.h"
+
+// Nearest pipe the bird has not yet fully passed: pipes are x-ordered, so the first one
+int NextPipeAhead(const Game *game) {
+    const Bird *bird = &game->bird;
+    const PipeRing *ring = &game->pipes;
+    float birdLeft = bird->position.x - bird->size.x * 0.5f;
+
+    for (int i = 0; i < ring->count; i++) {
+        if (ring->x[PipeSlot(ring, i)] + PIPE_WIDTH >= birdLeft) return i;
+    }
+    return -1;
+}
+
+// Simple bot: flap whenever the bird sinks below the middle of the next gap
+void AutopilotBot(const Game *game, GameInput *input, void *user) {
+    (void)user;
+    *input = (GameInput){ 0 };
+
+    if (game->state != GAME_RUNNING) {
+        input->flap = (game->state == GAME_WAITING || game->state == GAME_OVER);
+        return;
+    }
+
+    const Bird *bird = &game->bird;
+    int next = NextPipeAhead(game);
+
+    float targetY = SCREEN_HEIGHT / 2.0f;
+    if (next >= 0) {
+        Pipe pipe = GetPipe(game, next);
+        targetY = (pipe.top.height + pipe.bottom.y) * 0.5f;
+    }
+
+    input->flap = (bird->position.y > targetY + 10.0f && bird->velocity > 0.0f);
+}
\ No newline at end of file
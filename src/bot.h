@@ -0,0 +1,15 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "game.h"
+
+// --- STRUCTURES ---
+// Fills input for the next tick; user data is shared between threads, treat it as read-only
+typedef void (*GameBot)(const Game *game, GameInput *input, void *user);
+
+// --- FUNCTION PROTOTYPES ---
+// Ring position of the nearest pipe the bird has not fully passed, or -1
+int NextPipeAhead(const Game *game);
+void AutopilotBot(const Game *game, GameInput *input, void *user);
+
+#endif // BOT_H
\ No newline at end of file
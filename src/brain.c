@@ -0,0 +1,125 @@
+// src/brain.c
+#include "brain.h"
+#include "bot.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define BRAIN_MAGIC "FBNN"
+
+// x / (1 + |x|): tanh-shaped, but vectorizes without a libm call
+static float Softsign(float x) {
+    return x / (1.0f + fabsf(x));
+}
+
+// --- INPUTS ---
+// Everything scaled to roughly [-1, 1]
+void BrainInputs(const Game *game, float inputs[BRAIN_INPUTS]) {
+    const Bird *bird = &game->bird;
+    int nextIndex = NextPipeAhead(game);
+    Pipe next = { 0 }, after = { 0 };
+    bool haveNext = nextIndex >= 0;
+    // The pipe after next lets the network set up for the following gap
+    bool haveAfter = haveNext && nextIndex + 1 < game->pipes.count;
+    if (haveNext) next = GetPipe(game, nextIndex);
+    if (haveAfter) after = GetPipe(game, nextIndex + 1);
+
+    float gapTop = haveNext ? next.top.height : SCREEN_HEIGHT * 0.5f - MAX_GAP_SIZE * 0.5f;
+    float gapBottom = haveNext ? next.bottom.y : SCREEN_HEIGHT * 0.5f + MAX_GAP_SIZE * 0.5f;
+    float nextX = haveNext ? next.top.x : (float)SCREEN_WIDTH;
+    float afterMid = haveAfter ? (after.top.height + after.bottom.y) * 0.5f : (gapTop + gapBottom) * 0.5f;
+
+    inputs[0] = bird->position.y / SCREEN_HEIGHT * 2.0f - 1.0f;
+    inputs[1] = bird->velocity / MAX_FALL_SPEED;
+    inputs[2] = (nextX - bird->position.x) / SCREEN_WIDTH;
+    inputs[3] = (gapTop - bird->position.y) / SCREEN_HEIGHT * 2.0f;
+    inputs[4] = (gapBottom - bird->position.y) / SCREEN_HEIGHT * 2.0f;
+    inputs[5] = (afterMid - bird->position.y) / SCREEN_HEIGHT * 2.0f;
+}
+
+// --- INFERENCE ---
+float BrainForward(const Brain *brain, const float inputs[BRAIN_INPUTS]) {
+    const float *w = brain->w;
+    float out = w[BRAIN_WEIGHTS - 1];
+
+    for (int h = 0; h < BRAIN_HIDDEN; h++) {
+        const float *row = w + h * (BRAIN_INPUTS + 1);
+        float acc = row[BRAIN_INPUTS];
+        for (int i = 0; i < BRAIN_INPUTS; i++) {
+            acc += row[i] * inputs[i];
+        }
+        out += w[BRAIN_OUTPUT_W + h] * Softsign(acc);
+    }
+    return out;
+}
+
+// Same arithmetic as BrainForward in the same order, with the network index
+// innermost so each step is one contiguous, vectorizable pass over the population
+void BrainForwardBatch(const float *weights, const float *inputs, int stride, int count, float *outputs) {
+    const float *outBias = weights + (BRAIN_WEIGHTS - 1) * stride;
+    for (int g = 0; g < count; g++) outputs[g] = outBias[g];
+
+    float acc[256];
+    for (int base = 0; base < count; base += 256) {
+        int n = (count - base < 256) ? count - base : 256;
+
+        for (int h = 0; h < BRAIN_HIDDEN; h++) {
+            const float *row = weights + h * (BRAIN_INPUTS + 1) * stride + base;
+            const float *bias = row + BRAIN_INPUTS * stride;
+            for (int g = 0; g < n; g++) acc[g] = bias[g];
+
+            for (int i = 0; i < BRAIN_INPUTS; i++) {
+                const float *wi = row + i * stride;
+                const float *xi = inputs + i * stride + base;
+                for (int g = 0; g < n; g++) acc[g] += wi[g] * xi[g];
+            }
+
+            const float *wo = weights + (BRAIN_OUTPUT_W + h) * stride + base;
+            for (int g = 0; g < n; g++) outputs[base + g] += wo[g] * Softsign(acc[g]);
+        }
+    }
+}
+
+bool BrainFlap(const Brain *brain, const Game *game) {
+    float inputs[BRAIN_INPUTS];
+    BrainInputs(game, inputs);
+    return BrainForward(brain, inputs) > 0.0f;
+}
+
+// GameBot adapter; user is the const Brain *
+void BrainBot(const Game *game, GameInput *input, void *user) {
+    *input = (GameInput){ 0 };
+
+    if (game->state != GAME_RUNNING) {
+        input->flap = (game->state == GAME_WAITING || game->state == GAME_OVER);
+        return;
+    }
+    input->flap = BrainFlap((const Brain *)user, game);
+}
+
+// --- FILE I/O ---
+bool SaveBrain(const Brain *brain, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (!file) return false;
+
+    int shape[3] = { BRAIN_INPUTS, BRAIN_HIDDEN, BRAIN_WEIGHTS };
+    bool ok = fwrite(BRAIN_MAGIC, 1, 4, file) == 4 &&
+              fwrite(shape, sizeof(shape), 1, file) == 1 &&
+              fwrite(brain->w, sizeof(brain->w), 1, file) == 1;
+    fclose(file);
+    return ok;
+}
+
+bool LoadBrain(Brain *brain, const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return false;
+
+    char magic[4];
+    int shape[3];
+    bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, BRAIN_MAGIC, 4) == 0 &&
+              fread(shape, sizeof(shape), 1, file) == 1 &&
+              shape[0] == BRAIN_INPUTS && shape[1] == BRAIN_HIDDEN && shape[2] == BRAIN_WEIGHTS &&
+              fread(brain->w, sizeof(brain->w), 1, file) == 1;
+    fclose(file);
+    return ok;
+}
\ No newline at end of file
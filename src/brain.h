@@ -0,0 +1,34 @@
+#ifndef BRAIN_H
+#define BRAIN_H
+
+#include <stdbool.h>
+#include "game.h"
+
+// --- NETWORK SHAPE ---
+// inputs -> BRAIN_HIDDEN softsign units -> one output (flap when > 0)
+#define BRAIN_INPUTS   6
+#define BRAIN_HIDDEN   8
+#define BRAIN_OUTPUT_W (BRAIN_HIDDEN * (BRAIN_INPUTS + 1))     // first output weight
+#define BRAIN_WEIGHTS  (BRAIN_OUTPUT_W + BRAIN_HIDDEN + 1)
+
+// --- STRUCTURES ---
+// Hidden unit h uses w[h * (BRAIN_INPUTS + 1) + i], its bias at i = BRAIN_INPUTS;
+// the output layer follows at BRAIN_OUTPUT_W with its bias last
+typedef struct Brain {
+    float w[BRAIN_WEIGHTS];
+} Brain;
+
+// --- FUNCTION PROTOTYPES ---
+void BrainInputs(const Game *game, float inputs[BRAIN_INPUTS]);
+float BrainForward(const Brain *brain, const float inputs[BRAIN_INPUTS]);
+bool BrainFlap(const Brain *brain, const Game *game);
+void BrainBot(const Game *game, GameInput *input, void *user);
+
+// Whole population at once: weights[k * stride + g] is weight k of network g,
+// inputs[i * stride + g] its input i; writes one output per network
+void BrainForwardBatch(const float *weights, const float *inputs, int stride, int count, float *outputs);
+
+bool SaveBrain(const Brain *brain, const char *fileName);
+bool LoadBrain(Brain *brain, const char *fileName);
+
+#endif // BRAIN_H
\ No newline at end of file
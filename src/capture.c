@@ -0,0 +1,439 @@
+// src/capture.c
+#define _POSIX_C_SOURCE 200809L
+#include "capture.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Straight from the GL library raylib links against (-lGL, -lopengl32 or the OpenGL
+// framework, already on every build line), so a frame is read into one of our own buffers;
+// rlReadScreenPixels allocates two copies, flips them and waits for the GPU. rlgl has no
+// pixel pack buffers, so the buffer calls below come from the same library: exported
+// directly everywhere but Windows, where opengl32 only exports GL 1.1 and the rest comes
+// from wglGetProcAddress.
+#if defined(_WIN32)
+#define CAPTURE_GLAPI __stdcall
+#else
+#define CAPTURE_GLAPI
+#endif
+#define CAPTURE_GL_RGBA             0x1908
+#define CAPTURE_GL_UNSIGNED_BYTE    0x1401
+#define CAPTURE_GL_PIXEL_PACK       0x88EB
+#define CAPTURE_GL_STREAM_READ      0x88E1
+#define CAPTURE_GL_MAP_READ         0x0001
+extern void CAPTURE_GLAPI glReadPixels(int x, int y, int width, int height,
+                                       unsigned int format, unsigned int type, void *pixels);
+
+typedef void (CAPTURE_GLAPI *GenBuffersFn)(int count, unsigned int *buffers);
+typedef void (CAPTURE_GLAPI *DeleteBuffersFn)(int count, const unsigned int *buffers);
+typedef void (CAPTURE_GLAPI *BindBufferFn)(unsigned int target, unsigned int buffer);
+typedef void (CAPTURE_GLAPI *BufferDataFn)(unsigned int target, ptrdiff_t size, const void *data, unsigned int usage);
+typedef void *(CAPTURE_GLAPI *MapBufferRangeFn)(unsigned int target, ptrdiff_t offset, ptrdiff_t length, unsigned int access);
+typedef unsigned char (CAPTURE_GLAPI *UnmapBufferFn)(unsigned int target);
+
+#if defined(_WIN32)
+extern void *CAPTURE_GLAPI wglGetProcAddress(const char *name);
+#define CAPTURE_GL_PROC(type, name) ((type)wglGetProcAddress(#name))
+#else
+extern void CAPTURE_GLAPI glGenBuffers(int count, unsigned int *buffers);
+extern void CAPTURE_GLAPI glDeleteBuffers(int count, const unsigned int *buffers);
+extern void CAPTURE_GLAPI glBindBuffer(unsigned int target, unsigned int buffer);
+extern void CAPTURE_GLAPI glBufferData(unsigned int target, ptrdiff_t size, const void *data, unsigned int usage);
+extern void *CAPTURE_GLAPI glMapBufferRange(unsigned int target, ptrdiff_t offset, ptrdiff_t length, unsigned int access);
+extern unsigned char CAPTURE_GLAPI glUnmapBuffer(unsigned int target);
+#define CAPTURE_GL_PROC(type, name) (name)
+#endif
+
+static struct {
+    GenBuffersFn genBuffers;
+    DeleteBuffersFn deleteBuffers;
+    BindBufferFn bindBuffer;
+    BufferDataFn bufferData;
+    MapBufferRangeFn mapBufferRange;
+    UnmapBufferFn unmapBuffer;
+} gl;
+
+typedef struct CaptureSlot {
+    unsigned char *pixels;  // RGBA, bottom row first as GL reads it
+    int frame;              // frame number since StartCapture, counting dropped ones
+} CaptureSlot;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// --- SHARED STATE ---
+// The slots themselves move between the two sides through these index lists
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static CaptureSlot slots[CAPTURE_BUFFERS];
+static int freeSlots[CAPTURE_BUFFERS];
+static int freeCount;
+static int queued[CAPTURE_BUFFERS];     // ring, oldest at queueHead
+static int queueHead, queueCount;
+static bool closing;
+static int endFrame;                    // frames taken in all, set when closing
+static CaptureStats stats;
+
+// --- SET AT START ---
+static bool active;
+static pthread_t thread;
+static CaptureFormat format;
+static char outputPath[512];
+static int width, height;
+static int nextFrame;
+
+// --- READBACK RING ---
+// Main thread only. A frame read into a pixel pack buffer is only queued on the GPU;
+// it is mapped CAPTURE_READBACKS frames later, when the GPU is long done with it.
+static bool asyncReadback;              // false on GL 2.1 and older: read straight into a slot
+static unsigned int packBuffers[CAPTURE_READBACKS];
+static int packFrames[CAPTURE_READBACKS];   // frame each buffer holds, -1 if none
+static int packNext;                    // the oldest read, and the next buffer to reuse
+
+// --- ENCODER THREAD STATE ---
+static FILE *video;
+static unsigned char *yuv;              // last frame converted, repeated for dropped ones
+static size_t yuvSize;
+static int lastWritten = -1;
+
+// --- ENCODERS ---
+// Full-range BT.601, as C420jpeg declares, with each chroma sample averaged over 2x2
+static void ConvertYuv420(const unsigned char *rgba) {
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    unsigned char *planeY = yuv;
+    unsigned char *planeU = yuv + (size_t)width * height;
+    unsigned char *planeV = planeU + (size_t)chromaWidth * chromaHeight;
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char *row = rgba + (size_t)(height - 1 - y) * width * 4;
+        for (int x = 0; x < width; x++) {
+            const unsigned char *p = row + x * 4;
+            planeY[(size_t)y * width + x] = (unsigned char)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                int y = cy * 2 + dy;
+                if (y >= height) continue;
+                const unsigned char *row = rgba + (size_t)(height - 1 - y) * width * 4;
+                for (int dx = 0; dx < 2; dx++) {
+                    int x = cx * 2 + dx;
+                    if (x >= width) continue;
+                    r += row[x * 4];
+                    g += row[x * 4 + 1];
+                    b += row[x * 4 + 2];
+                    n++;
+                }
+            }
+            r /= n; g /= n; b /= n;
+            int u = (-43 * r - 85 * g + 128 * b + 128) / 256 + 128;
+            int v = (128 * r - 107 * g - 21 * b + 128) / 256 + 128;
+            planeU[(size_t)cy * chromaWidth + cx] = (unsigned char)(u < 0 ? 0 : u > 255 ? 255 : u);
+            planeV[(size_t)cy * chromaWidth + cx] = (unsigned char)(v < 0 ? 0 : v > 255 ? 255 : v);
+        }
+    }
+}
+
+static bool WriteVideoFrame(size_t *written) {
+    if (fputs("FRAME\n", video) < 0 || fwrite(yuv, 1, yuvSize, video) != yuvSize) return false;
+    *written += 6 + yuvSize;
+    return true;
+}
+
+// Holds the previous picture over frames that were dropped, up to `frame`
+static bool FillY4m(int frame, size_t *written) {
+    bool ok = true;
+    if (lastWritten < 0) return ok;
+    for (; lastWritten + 1 < frame; lastWritten++) ok = WriteVideoFrame(written) && ok;
+    return ok;
+}
+
+static bool EncodeY4m(const CaptureSlot *slot, size_t *written) {
+    bool ok = FillY4m(slot->frame, written);
+    ConvertYuv420(slot->pixels);
+    ok = WriteVideoFrame(written) && ok;
+    lastWritten = slot->frame;
+    return ok;
+}
+
+// The framebuffer's alpha is what blending left behind, not coverage, so it is dropped.
+// ExportImageToMemory rather than ExportImage, which would log every file it writes.
+static bool EncodePng(CaptureSlot *slot, size_t *written) {
+    size_t stride = (size_t)width * 4;
+    unsigned char *top = slot->pixels;
+    unsigned char *bottom = slot->pixels + (height - 1) * stride;
+    for (; top < bottom; top += stride, bottom -= stride) {
+        for (size_t i = 0; i < stride; i++) {
+            unsigned char t = top[i];
+            top[i] = bottom[i];
+            bottom[i] = t;
+        }
+    }
+    for (size_t i = 3; i < stride * height; i += 4) slot->pixels[i] = 255;
+
+    Image image = { slot->pixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    int size = 0;
+    unsigned char *png = ExportImageToMemory(image, ".png", &size);
+    if (png == NULL) return false;
+
+    char name[sizeof(outputPath) + 16];
+    snprintf(name, sizeof(name), "%s_%06d.png", outputPath, slot->frame);
+    FILE *file = fopen(name, "wb");
+    bool ok = file != NULL && fwrite(png, 1, (size_t)size, file) == (size_t)size;
+    if (file != NULL && fclose(file) != 0) ok = false;
+    MemFree(png);
+
+    if (ok) *written += (size_t)size;
+    return ok;
+}
+
+static void *EncoderMain(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (queueCount == 0 && !closing) pthread_cond_wait(&wake, &lock);
+        if (queueCount == 0) break;
+
+        int index = queued[queueHead];
+        queueHead = (queueHead + 1) % CAPTURE_BUFFERS;
+        queueCount--;
+        pthread_mutex_unlock(&lock);
+
+        double start = NowSeconds();
+        size_t written = 0;
+        bool ok = (format == CAPTURE_Y4M) ? EncodeY4m(&slots[index], &written)
+                                          : EncodePng(&slots[index], &written);
+        double busy = NowSeconds() - start;
+
+        pthread_mutex_lock(&lock);
+        freeSlots[freeCount++] = index;
+        if (ok) stats.encoded++;
+        else stats.failed++;
+        stats.encodeSeconds += busy;
+        stats.megabytes += written / (1024.0 * 1024.0);
+    }
+    pthread_mutex_unlock(&lock);
+
+    // Frames dropped at the very end still take up their time in a video
+    size_t written = 0;
+    bool ok = format != CAPTURE_Y4M || FillY4m(endFrame, &written);
+    pthread_mutex_lock(&lock);
+    if (!ok) stats.failed++;
+    stats.megabytes += written / (1024.0 * 1024.0);
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+// --- MAIN THREAD ---
+static void FreeSlots(void) {
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        free(slots[i].pixels);
+        slots[i].pixels = NULL;
+    }
+    free(yuv);
+    yuv = NULL;
+}
+
+// Falls back to reading into the slots if the context can't map buffers (GL 3.0)
+static void StartReadback(void) {
+    int version = rlGetVersion();
+    asyncReadback = version == RL_OPENGL_33 || version == RL_OPENGL_43;
+    if (asyncReadback) {
+        gl.genBuffers = CAPTURE_GL_PROC(GenBuffersFn, glGenBuffers);
+        gl.deleteBuffers = CAPTURE_GL_PROC(DeleteBuffersFn, glDeleteBuffers);
+        gl.bindBuffer = CAPTURE_GL_PROC(BindBufferFn, glBindBuffer);
+        gl.bufferData = CAPTURE_GL_PROC(BufferDataFn, glBufferData);
+        gl.mapBufferRange = CAPTURE_GL_PROC(MapBufferRangeFn, glMapBufferRange);
+        gl.unmapBuffer = CAPTURE_GL_PROC(UnmapBufferFn, glUnmapBuffer);
+        asyncReadback = gl.genBuffers && gl.deleteBuffers && gl.bindBuffer && gl.bufferData &&
+                        gl.mapBufferRange && gl.unmapBuffer;
+    }
+    if (!asyncReadback) {
+        TraceLog(LOG_WARNING, "CAPTURE: No pixel pack buffers, reading frames synchronously");
+        return;
+    }
+
+    gl.genBuffers(CAPTURE_READBACKS, packBuffers);
+    for (int i = 0; i < CAPTURE_READBACKS; i++) {
+        gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, packBuffers[i]);
+        gl.bufferData(CAPTURE_GL_PIXEL_PACK, (ptrdiff_t)width * height * 4, NULL, CAPTURE_GL_STREAM_READ);
+        packFrames[i] = -1;
+    }
+    gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, 0);
+    packNext = 0;
+}
+
+static void StopReadback(void) {
+    if (!asyncReadback) return;
+    gl.deleteBuffers(CAPTURE_READBACKS, packBuffers);
+    asyncReadback = false;
+}
+
+// A free slot, or -1 with the frame counted as dropped
+static int TakeSlot(void) {
+    pthread_mutex_lock(&lock);
+    int index = (freeCount > 0) ? freeSlots[--freeCount] : -1;
+    if (index < 0) stats.dropped++;
+    pthread_mutex_unlock(&lock);
+    return index;
+}
+
+static void QueueSlot(int index, int frame, bool ok) {
+    pthread_mutex_lock(&lock);
+    if (ok) {
+        slots[index].frame = frame;
+        queued[(queueHead + queueCount) % CAPTURE_BUFFERS] = index;
+        queueCount++;
+        stats.captured++;
+        pthread_cond_signal(&wake);
+    } else {
+        freeSlots[freeCount++] = index;
+        stats.failed++;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+// Copies a finished read into a slot for the encoder. The pool only fills up here, so
+// the GPU never waits on the encoder; a dropped frame just leaves its buffer unread.
+static void RetireReadback(int pack) {
+    int frame = packFrames[pack];
+    if (frame < 0) return;
+    packFrames[pack] = -1;
+    int index = TakeSlot();
+    if (index < 0) return;
+
+    size_t size = (size_t)width * height * 4;
+    gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, packBuffers[pack]);
+    const void *pixels = gl.mapBufferRange(CAPTURE_GL_PIXEL_PACK, 0, (ptrdiff_t)size, CAPTURE_GL_MAP_READ);
+    if (pixels != NULL) {
+        memcpy(slots[index].pixels, pixels, size);
+        gl.unmapBuffer(CAPTURE_GL_PIXEL_PACK);
+    }
+    gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, 0);
+    QueueSlot(index, frame, pixels != NULL);
+}
+
+bool StartCapture(const char *path, int fps) {
+    if (active) return false;
+
+    width = GetRenderWidth();
+    height = GetRenderHeight();
+    size_t length = strlen(path);
+    format = (length > 4 && strcmp(path + length - 4, ".y4m") == 0) ? CAPTURE_Y4M : CAPTURE_PNG;
+    snprintf(outputPath, sizeof(outputPath), "%s", path);
+
+    for (int i = 0; i < CAPTURE_BUFFERS; i++) {
+        slots[i].pixels = malloc((size_t)width * height * 4);
+        if (slots[i].pixels == NULL) {
+            FreeSlots();
+            return false;
+        }
+        freeSlots[i] = i;
+    }
+    freeCount = CAPTURE_BUFFERS;
+    queueHead = queueCount = 0;
+    closing = false;
+    nextFrame = 0;
+    lastWritten = -1;
+    stats = (CaptureStats){ .active = true, .format = format };
+
+    if (format == CAPTURE_Y4M) {
+        yuvSize = (size_t)width * height + 2 * (size_t)((width + 1) / 2) * ((height + 1) / 2);
+        yuv = malloc(yuvSize);
+        video = fopen(path, "wb");
+        if (yuv == NULL || video == NULL) {
+            if (video != NULL) fclose(video);
+            video = NULL;
+            FreeSlots();
+            return false;
+        }
+        fprintf(video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+    }
+
+    if (pthread_create(&thread, NULL, EncoderMain, NULL) != 0) {
+        if (video != NULL) fclose(video);
+        video = NULL;
+        FreeSlots();
+        return false;
+    }
+
+    StartReadback();
+    active = true;
+    TraceLog(LOG_INFO, "CAPTURE: Recording %dx%d at %d fps to %s%s", width, height, fps, path,
+             (format == CAPTURE_PNG) ? "_*.png" : "");
+    return true;
+}
+
+void CaptureFrame(void) {
+    if (!active) return;
+    int frame = nextFrame++;
+
+    // The frame is still partly in the batch; flush it so the read sees all of it
+    rlDrawRenderBatchActive();
+
+    if (!asyncReadback) {
+        int index = TakeSlot();
+        if (index < 0) return;
+        glReadPixels(0, 0, width, height, CAPTURE_GL_RGBA, CAPTURE_GL_UNSIGNED_BYTE, slots[index].pixels);
+        QueueSlot(index, frame, true);
+        return;
+    }
+
+    // The oldest buffer is retired before it is reused, so this frame is read back in
+    // CAPTURE_READBACKS frames' time. With a pack buffer bound, the pointer is an offset.
+    int pack = packNext;
+    packNext = (packNext + 1) % CAPTURE_READBACKS;
+    RetireReadback(pack);
+    gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, packBuffers[pack]);
+    glReadPixels(0, 0, width, height, CAPTURE_GL_RGBA, CAPTURE_GL_UNSIGNED_BYTE, NULL);
+    gl.bindBuffer(CAPTURE_GL_PIXEL_PACK, 0);
+    packFrames[pack] = frame;
+}
+
+void StopCapture(void) {
+    if (!active) return;
+
+    // The last few frames are still on the GPU; these maps are the only ones that wait
+    for (int i = 0; i < CAPTURE_READBACKS && asyncReadback; i++) {
+        RetireReadback((packNext + i) % CAPTURE_READBACKS);
+    }
+    StopReadback();
+
+    pthread_mutex_lock(&lock);
+    closing = true;
+    endFrame = nextFrame;
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(thread, NULL);
+
+    if (video != NULL && fclose(video) != 0) stats.failed++;
+    video = NULL;
+    FreeSlots();
+    active = false;
+
+    CaptureStats totals;
+    GetCaptureStats(&totals);
+    TraceLog(LOG_INFO, "CAPTURE: %d frames encoded, %d dropped, %d failed; encoder %.1f fps, %.1f MB/s",
+             totals.encoded, totals.dropped, totals.failed, totals.fps,
+             (totals.encodeSeconds > 0.0) ? totals.megabytes / totals.encodeSeconds : 0.0);
+}
+
+void GetCaptureStats(CaptureStats *out) {
+    pthread_mutex_lock(&lock);
+    *out = stats;
+    pthread_mutex_unlock(&lock);
+    out->active = active;
+    out->fps = (out->encodeSeconds > 0.0) ? out->encoded / out->encodeSeconds : 0.0;
+}
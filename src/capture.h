@@ -0,0 +1,44 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdbool.h>
+
+// --- CAPTURE CONSTANTS ---
+#define CAPTURE_BUFFERS     8       // frames read back and waiting for the encoder; a ninth is dropped
+#define CAPTURE_READBACKS   3       // frames in flight on the GPU before one reaches a buffer
+#define CAPTURE_FPS         60      // replay captures step the game this many times per video second
+
+// A path ending in .y4m is written as one YUV4MPEG2 (4:2:0) video; any other path is a
+// prefix for a PNG sequence, <path>_000000.png onwards.
+typedef enum CaptureFormat {
+    CAPTURE_PNG,
+    CAPTURE_Y4M
+} CaptureFormat;
+
+// --- STRUCTURES ---
+typedef struct CaptureStats {
+    bool active;
+    CaptureFormat format;
+    int captured;           // frames read back and queued
+    int encoded;
+    int dropped;            // frames not captured because every buffer was still queued
+    int failed;             // frames the encoder could not write
+    double encodeSeconds;   // time the encoder thread spent busy
+    double fps;             // frames encoded per busy second
+    double megabytes;       // written to the output
+} CaptureStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Main thread only, after InitWindow. Frames are read back through pixel pack buffers a
+// few frames behind the GPU (synchronously on GL 2.1), copied into a fixed pool of buffers
+// and encoded on a background thread; when the pool is used up a frame is dropped rather
+// than waiting, so the encoder never holds up EndDrawing. A video repeats the last
+// frame in place of a dropped one to keep its timing; a PNG sequence skips its number.
+bool StartCapture(const char *path, int fps);
+// After the frame is drawn and before EndDrawing
+void CaptureFrame(void);
+// Encodes what is still queued, closes the output and logs the totals
+void StopCapture(void);
+void GetCaptureStats(CaptureStats *stats);
+
+#endif // CAPTURE_H
@@ -0,0 +1,106 @@
+// src/course.c
+#include "course.h"
+#include "game.h"
+#include "player.h"
+#include <math.h>
+
+// Each flap sets the velocity to FLAP_STRENGTH, so holding a height costs one arc of this size
+#define HOVER_BAND (FLAP_STRENGTH * FLAP_STRENGTH / (2.0f * GRAVITY))
+
+static const char *const courseNames[COURSE_CURVES] = {
+    [COURSE_CLASSIC] = "CLASSIC",
+    [COURSE_ENDLESS] = "ENDLESS"
+};
+
+const char *CourseName(CourseCurve curve) {
+    return courseNames[curve];
+}
+
+float CourseMinGap(void) {
+    return BIRD_HEIGHT + HOVER_BAND + COURSE_GAP_MARGIN;
+}
+
+// --- REACHABILITY ---
+// Time between the bird clearing one pipe and reaching the next
+static float FreeTime(float spacing) {
+    float t = spacing - (PIPE_WIDTH + BIRD_WIDTH) / PIPE_SPEED;
+    return (t > 0.0f) ? t : 0.0f;
+}
+
+// Flapping every tick holds the velocity near FLAP_STRENGTH
+static float MaxClimb(float t) {
+    return -FLAP_STRENGTH * t * COURSE_REACH;
+}
+
+// Free fall from a standstill, capped at MAX_FALL_SPEED
+static float MaxDrop(float t) {
+    float capped = MAX_FALL_SPEED / GRAVITY;
+    float drop = (t < capped) ? 0.5f * GRAVITY * t * t
+                              : 0.5f * GRAVITY * capped * capped + MAX_FALL_SPEED * (t - capped);
+    return drop * COURSE_REACH;
+}
+
+static float GapCenter(const PipeSegment *segment) {
+    return (segment->gapTop + segment->gapBottom) * 0.5f;
+}
+
+bool CourseTransitionReachable(const PipeSegment *from, const PipeSegment *to) {
+    float t = FreeTime(from->spacing);
+    float delta = GapCenter(to) - GapCenter(from);     // positive = further down
+    return (to->gapBottom - to->gapTop) >= CourseMinGap() - 0.5f &&
+           delta <= MaxDrop(t) + 0.5f && -delta <= MaxClimb(t) + 0.5f;
+}
+
+// --- GENERATION ---
+static float Lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// Difficulty ramps linearly over COURSE_RAMP_PIPES: the gap range slides down to just
+// above CourseMinGap and the spacing range down to COURSE_MIN_SPACING. Each gap is then
+// placed only as far from the last one as the bird can climb or fall in between.
+static PipeSegment EndlessSegment(const Course *course, unsigned int *rng) {
+    float difficulty = (float)course->index / COURSE_RAMP_PIPES;
+    if (difficulty > 1.0f) difficulty = 1.0f;
+
+    float minGap = CourseMinGap();
+    int gapSize = RandomRange(rng, (int)ceilf(Lerp(MIN_GAP_SIZE, minGap, difficulty)),
+                                   (int)ceilf(Lerp(MAX_GAP_SIZE, minGap + 20.0f, difficulty)));
+    int spacingMs = RandomRange(rng, (int)(Lerp(PIPE_SPAWN_TIME, COURSE_MIN_SPACING, difficulty) * 1000.0f),
+                                     (int)(PIPE_SPAWN_TIME * 1000.0f));
+
+    float top = COURSE_EDGE;
+    float bottom = (float)(SCREEN_HEIGHT - COURSE_EDGE - gapSize);
+    if (course->index > 0) {
+        float t = FreeTime(course->last.spacing);
+        float center = GapCenter(&course->last) - gapSize * 0.5f;
+        top = fmaxf(top, center - MaxClimb(t));
+        bottom = fminf(bottom, center + MaxDrop(t));
+    }
+    int low = (int)ceilf(top), high = (int)floorf(bottom);
+    int gapY = RandomRange(rng, low, (high > low) ? high : low);
+
+    return (PipeSegment){ (float)gapY, (float)(gapY + gapSize), spacingMs / 1000.0f };
+}
+
+void StartCourse(Course *course, CourseCurve curve) {
+    course->curve = curve;
+    course->index = 0;
+    course->last = (PipeSegment){ 0 };
+}
+
+PipeSegment NextCourseSegment(Course *course, unsigned int *rng) {
+    PipeSegment segment;
+    if (course->curve == COURSE_ENDLESS) {
+        segment = EndlessSegment(course, rng);
+    } else {
+        // The original draws, so classic seeds and recorded replays keep their layout
+        int gapSize = RandomRange(rng, MIN_GAP_SIZE, MAX_GAP_SIZE);
+        int gapY = RandomRange(rng, COURSE_EDGE, SCREEN_HEIGHT - COURSE_EDGE - gapSize);
+        segment = (PipeSegment){ (float)gapY, (float)(gapY + gapSize), PIPE_SPAWN_TIME };
+    }
+
+    course->last = segment;
+    course->index++;
+    return segment;
+}
@@ -0,0 +1,45 @@
+#ifndef COURSE_H
+#define COURSE_H
+
+#include <stdbool.h>
+
+// --- COURSE CONSTANTS ---
+typedef enum CourseCurve {
+    COURSE_CLASSIC,         // the original layout: any gap anywhere, fixed spacing
+    COURSE_ENDLESS,         // gaps shrink and spacing tightens; every transition is reachable
+    COURSE_CURVES
+} CourseCurve;
+
+#define COURSE_EDGE         60      // gaps keep this far from the top and bottom of the screen
+#define COURSE_RAMP_PIPES   80      // ENDLESS pipes until full difficulty
+#define COURSE_MIN_SPACING  1.3f    // shortest ENDLESS spacing in seconds, at full difficulty
+#define COURSE_GAP_MARGIN   12.0f   // room around the bird's hover band in the tightest gap
+#define COURSE_REACH        0.75f   // share of the bird's best climb/drop a transition may ask for
+
+// --- STRUCTURES ---
+typedef struct PipeSegment {
+    float gapTop;
+    float gapBottom;
+    float spacing;          // seconds until the next pipe spawns
+} PipeSegment;
+
+// The generator's whole state. It is plain data inside Game, so copies, replays and
+// re-simulation from a snapshot all produce the same course for the same seed.
+typedef struct Course {
+    CourseCurve curve;
+    int index;              // segments generated this run
+    PipeSegment last;
+} Course;
+
+// --- FUNCTION PROTOTYPES ---
+void StartCourse(Course *course, CourseCurve curve);
+// Draws from the game's pipe stream; CLASSIC draws exactly as the original SpawnPipe
+PipeSegment NextCourseSegment(Course *course, unsigned int *rng);
+
+// Can a bird clearing `from` make it into the gap of `to`? ENDLESS only generates such pairs.
+bool CourseTransitionReachable(const PipeSegment *from, const PipeSegment *to);
+// Narrowest gap ENDLESS uses: the bird plus one flap arc plus COURSE_GAP_MARGIN
+float CourseMinGap(void);
+const char *CourseName(CourseCurve curve);
+
+#endif // COURSE_H
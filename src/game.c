@@ -2,41 +2,43 @@
 #include "game.h"
 #include "player.h"
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 #include <math.h>
-#include <stdio.h>
 
-#define PIPE_CAPACITY   16
-#define PIPE_CAP_HEIGHT 24
-
-// --- HELPER FUNCTION PROTOTYPES ---
-static void DrawWaitingScreen(const Game *game);
-static void DrawGameOverScreen(const Game *game);
-static void DrawPauseScreen(const Game *game);
-static void DrawSettingsScreen(const Game *game);
-static void DrawLives(const Game *game);
-static void DrawRespawnCountdown(const Game *game);
+#define VOLUME_RATE     0.6f      // volume change per second while UP/DOWN is held
 
 // --- SETTINGS ---
-void SaveSettings(const Settings *settings) {
-    FILE *file = fopen("settings.dat", "wb");
-    if (file) {
-        fwrite(settings, sizeof(Settings), 1, file);
-        fclose(file);
-    }
+// Persisted by the store (store.c); the core only knows the defaults
+void DefaultSettings(Settings *settings) {
+    settings->musicVolume = 0.5f;
+    settings->sfxVolume = 0.7f;
+    settings->screenShake = true;
+    settings->course = COURSE_CLASSIC;
 }
 
-void LoadSettings(Settings *settings) {
-    FILE *file = fopen("settings.dat", "rb");
-    if (file) {
-        fread(settings, sizeof(Settings), 1, file);
-        fclose(file);
-    } else {
-        // Default settings
-        settings->musicVolume = 0.5f;
-        settings->sfxVolume = 0.7f;
-        settings->screenShake = true;
-    }
+// --- RANDOM ---
+// Scramble any seed (including 0 or sequential values) into a usable xorshift state
+unsigned int SeedRandom(unsigned int seed) {
+    seed ^= seed >> 16;
+    seed *= 0x85EBCA6Bu;
+    seed ^= seed >> 13;
+    seed *= 0xC2B2AE35u;
+    seed ^= seed >> 16;
+    return seed ? seed : 0x9E3779B9u;
+}
+
+// xorshift32: tiny, fast and identical on every platform, unlike rand()
+unsigned int NextRandom(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+int RandomRange(unsigned int *state, int min, int max) {
+    return min + (int)(NextRandom(state) % (unsigned int)(max - min + 1));
 }
 
 // --- SCREEN SHAKE ---
@@ -51,8 +53,8 @@ void UpdateScreenShake(Game *game, float dt) {
     if (game->shakeTimer > 0.0f) {
         game->shakeTimer -= dt;
         
-        // Random shake offset
-        float angle = (float)(rand() % 360) * DEG2RAD;
+        // Random shake offset (own stream, so cosmetics never change the course)
+        float angle = (float)RandomRange(&game->fxRng, 0, 359) * DEG2RAD;
         float intensity = game->shakeMagnitude * (game->shakeTimer / 0.3f); // Fade out
         
         game->shakeOffset.x = cosf(angle) * intensity;
@@ -63,134 +65,302 @@ void UpdateScreenShake(Game *game, float dt) {
     }
 }
 
-// --- ASSETS ---
-static void InitAssets(Game *game) {
-    game->texBird = LoadTexture("assets/bird.png");
-    game->texPipe = LoadTexture("assets/pipe.png");
-    game->texBg   = LoadTexture("assets/bg.png");
+// --- EVENTS ---
+static void PushEvent(GameEvents *events, GameEventType type) {
+    if (events->count < MAX_GAME_EVENTS) {
+        events->items[events->count++] = type;
+    }
+}
 
-    InitAudioDevice();
-    game->sFlap  = LoadSound("assets/sounds/flap.wav");
-    game->sScore = LoadSound("assets/sounds/score.wav");
-    game->sHit   = LoadSound("assets/sounds/hit.wav");
+// Same test as raylib's CheckCollisionRecs, kept local so the core links without raylib
+static bool RectsOverlap(Rectangle a, Rectangle b) {
+    return (a.x < b.x + b.width) && (a.x + a.width > b.x) &&
+           (a.y < b.y + b.height) && (a.y + a.height > b.y);
+}
 
-    // Load font with proper size for better rendering
-    game->font = LoadFontEx("assets/font.ttf", 64, NULL, 0);
-    
-    // Apply volume settings
-    SetSoundVolume(game->sFlap, game->settings.sfxVolume);
-    SetSoundVolume(game->sScore, game->settings.sfxVolume);
-    SetSoundVolume(game->sHit, game->settings.sfxVolume);
+// Narrows [enter, exit] to the part of the step where the boxes overlap on one axis
+static bool SweepAxis(float aMin, float aSize, float d, float bMin, float bSize, float *enter, float *exit) {
+    float aMax = aMin + aSize;
+    float bMax = bMin + bSize;
+
+    // Not moving on this axis: overlapping for the whole step or never
+    if (d == 0.0f) return aMin < bMax && aMax > bMin;
+
+    // One reciprocal per axis, so SIMD callers can share it across many boxes
+    float inv = 1.0f / d;
+    float t0 = (bMin - aMax) * inv;     // edges start to overlap
+    float t1 = (bMax - aMin) * inv;     // edges separate again
+    if (d < 0.0f) {
+        float swap = t0;
+        t0 = t1;
+        t1 = swap;
+    }
+
+    if (t0 > *enter) *enter = t0;
+    if (t1 < *exit) *exit = t1;
+    return *enter < *exit;
+}
+
+bool SweepRects(Rectangle from, Vector2 motion, Rectangle target, float *toi) {
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (!SweepAxis(from.x, from.width, motion.x, target.x, target.width, &enter, &exit)) return false;
+    if (!SweepAxis(from.y, from.height, motion.y, target.y, target.height, &enter, &exit)) return false;
+
+    *toi = enter;
+    return true;
+}
+
+// --- PIPE RING ---
+int PipeSlot(const PipeRing *ring, int i) {
+    return (ring->head + i) & (ring->capacity - 1);
 }
 
-static void UnloadAssets(Game *game) {
-    UnloadTexture(game->texBird);
-    UnloadTexture(game->texPipe);
-    UnloadTexture(game->texBg);
+unsigned int PipeSerial(const PipeRing *ring, int i) {
+    return ring->spawned - (unsigned int)ring->count + (unsigned int)i;
+}
+
+Pipe GetPipe(const Game *game, int i) {
+    const PipeRing *ring = &game->pipes;
+    int s = PipeSlot(ring, i);
 
-    UnloadSound(game->sFlap);
-    UnloadSound(game->sScore);
-    UnloadSound(game->sHit);
+    Pipe pipe;
+    pipe.top = (Rectangle){ ring->x[s], 0.0f, PIPE_WIDTH, ring->gapTop[s] };
+    pipe.bottom = (Rectangle){ ring->x[s], ring->gapBottom[s], PIPE_WIDTH, SCREEN_HEIGHT - ring->gapBottom[s] };
+    pipe.scored = ring->scored[s];
+    return pipe;
+}
 
-    UnloadFont(game->font);
-    CloseAudioDevice();
+// Grows the storage to hold at least `capacity` pipes, unwrapping them to slot 0.
+// Leaves the ring untouched and returns false if the allocation fails.
+static bool ReservePipes(PipeRing *ring, int capacity) {
+    if (capacity <= ring->capacity) return true;
+
+    int grown = ring->capacity ? ring->capacity : PIPE_CAPACITY;
+    while (grown < capacity) grown *= 2;
+
+    // One block: x | gapTop | gapBottom | scored
+    float *block = malloc((size_t)grown * (3 * sizeof(float) + sizeof(bool)));
+    if (block == NULL) return false;
+
+    PipeRing next = *ring;
+    next.x = block;
+    next.gapTop = block + grown;
+    next.gapBottom = block + 2 * grown;
+    next.scored = (bool *)(block + 3 * grown);
+    next.head = 0;
+    next.capacity = grown;
+
+    for (int i = 0; i < ring->count; i++) {
+        int s = PipeSlot(ring, i);
+        next.x[i] = ring->x[s];
+        next.gapTop[i] = ring->gapTop[s];
+        next.gapBottom[i] = ring->gapBottom[s];
+        next.scored[i] = ring->scored[s];
+    }
+
+    free(ring->x);
+    *ring = next;
+    return true;
+}
+
+static void ClearPipes(PipeRing *ring) {
+    ring->head = 0;
+    ring->count = 0;
+}
+
+static void CopyPipes(PipeRing *dst, const PipeRing *src) {
+    int count = src->count;
+    if (!ReservePipes(dst, count)) count = dst->capacity;
+
+    // Newest pipes win if dst could not grow
+    int skip = src->count - count;
+    for (int i = 0; i < count; i++) {
+        int s = PipeSlot(src, skip + i);
+        dst->x[i] = src->x[s];
+        dst->gapTop[i] = src->gapTop[s];
+        dst->gapBottom[i] = src->gapBottom[s];
+        dst->scored[i] = src->scored[s];
+    }
+
+    dst->head = 0;
+    dst->count = count;
+    dst->spawned = src->spawned;
+}
+
+// Scroll every live pipe; the ring is at most two contiguous runs
+static void ScrollPipes(PipeRing *ring, float step) {
+    int run = ring->capacity - ring->head;
+    if (run > ring->count) run = ring->count;
+
+    float *x = ring->x + ring->head;
+    for (int i = 0; i < run; i++) x[i] -= step;
+
+    x = ring->x;
+    for (int i = 0; i < ring->count - run; i++) x[i] -= step;
+}
+
+// Impact of the bird with either half of pipe slot s this step. The swept test runs in
+// the pipe's start-of-step frame; the end-of-step overlap is checked as well so that
+// rounding in the sweep can never lose a hit the old discrete test would have found.
+static bool SweepPipe(const PipeRing *ring, int s, Rectangle birdFrom, Vector2 motion, Rectangle birdTo, float *toi) {
+    float x0 = ring->x[s];
+    Rectangle top = { x0, 0.0f, PIPE_WIDTH, ring->gapTop[s] };
+    Rectangle bottom = { x0, ring->gapBottom[s], PIPE_WIDTH, SCREEN_HEIGHT - ring->gapBottom[s] };
+
+    float tTop = 2.0f, tBottom = 2.0f;
+    SweepRects(birdFrom, motion, top, &tTop);
+    SweepRects(birdFrom, motion, bottom, &tBottom);
+
+    top.x = bottom.x = x0 - motion.x;
+    if (RectsOverlap(birdTo, top) && tTop > 1.0f) tTop = 1.0f;
+    if (RectsOverlap(birdTo, bottom) && tBottom > 1.0f) tBottom = 1.0f;
+
+    *toi = (tTop < tBottom) ? tTop : tBottom;
+    return *toi <= 1.0f;
 }
 
 // --- GAME LIFECYCLE ---
-void InitGame(Game *game) {
-    srand((unsigned int)time(NULL));
+void InitGame(Game *game, unsigned int seed) {
+    game->seed = seed;
+    game->rng = SeedRandom(seed);
+    game->seedRng = SeedRandom(seed + 1);
+    game->fxRng = SeedRandom(seed + 2);
+    game->runTick = 0;
 
     game->state = GAME_WAITING;
     game->score = 0;
     game->highScore = 0;
     game->lives = MAX_LIVES;
     game->pipeSpawnTimer = 0.0f;
-    game->pipeCount = 0;
     game->respawnTimer = 0.0f;
     
     game->shakeTimer = 0.0f;
     game->shakeMagnitude = 0.0f;
     game->shakeOffset = (Vector2){0, 0};
 
-    LoadSettings(&game->settings);
-    InitAssets(game);
+    DefaultSettings(&game->settings);
+    StartCourse(&game->course, game->settings.course);
     InitBird(&game->bird);
 
-    for (int i = 0; i < PIPE_CAPACITY; i++) {
-        game->pipes[i].active = false;
-        game->pipes[i].scored = false;
-    }
+    game->pipes = (PipeRing){ 0 };
+    ReservePipes(&game->pipes, PIPE_CAPACITY);
 
     SpawnPipe(game);
 }
 
-void ResetGame(Game *game) {
+void FreeGame(Game *game) {
+    free(game->pipes.x);
+    game->pipes = (PipeRing){ 0 };
+}
+
+void CopyGame(Game *dst, const Game *src) {
+    PipeRing pipes = dst->pipes;
+    *dst = *src;
+    dst->pipes = pipes;
+    CopyPipes(&dst->pipes, &src->pipes);
+}
+
+// --- SNAPSHOTS ---
+// Unused pipe slots are zeroed so that they never show up in a diff
+void SaveGameSnapshot(GameSnapshot *snapshot, const Game *game) {
+    const PipeRing *ring = &game->pipes;
+    int count = (ring->count < SNAPSHOT_PIPES) ? ring->count : SNAPSHOT_PIPES;
+    int skip = ring->count - count;
+
+    memcpy(&snapshot->game, game, sizeof(Game));
+    snapshot->game.pipes = (PipeRing){ .count = count, .spawned = ring->spawned };
+
+    memset(snapshot->pipeX, 0, sizeof(snapshot->pipeX));
+    memset(snapshot->pipeGapTop, 0, sizeof(snapshot->pipeGapTop));
+    memset(snapshot->pipeGapBottom, 0, sizeof(snapshot->pipeGapBottom));
+    memset(snapshot->pipeScored, 0, sizeof(snapshot->pipeScored));
+    for (int i = 0; i < count; i++) {
+        int s = PipeSlot(ring, skip + i);
+        int slot = PipeSerial(ring, skip + i) % SNAPSHOT_PIPES;
+        snapshot->pipeX[slot] = ring->x[s];
+        snapshot->pipeGapTop[slot] = ring->gapTop[s];
+        snapshot->pipeGapBottom[slot] = ring->gapBottom[s];
+        snapshot->pipeScored[slot] = ring->scored[s];
+    }
+}
+
+bool LoadGameSnapshot(Game *game, const GameSnapshot *snapshot) {
+    PipeRing pipes = game->pipes;
+    int count = snapshot->game.pipes.count;
+    if (!ReservePipes(&pipes, (count > PIPE_CAPACITY) ? count : PIPE_CAPACITY)) return false;
+
+    memcpy(game, &snapshot->game, sizeof(Game));
+    pipes.head = 0;
+    pipes.count = count;
+    pipes.spawned = snapshot->game.pipes.spawned;
+    for (int i = 0; i < count; i++) {
+        int slot = PipeSerial(&pipes, i) % SNAPSHOT_PIPES;
+        pipes.x[i] = snapshot->pipeX[slot];
+        pipes.gapTop[i] = snapshot->pipeGapTop[slot];
+        pipes.gapBottom[i] = snapshot->pipeGapBottom[slot];
+        pipes.scored[i] = snapshot->pipeScored[slot];
+    }
+    game->pipes = pipes;
+    return true;
+}
+
+// Start a run whose pipe layout depends only on seed (what replays store)
+void ResetGame(Game *game, unsigned int seed) {
+    game->seed = seed;
+    game->rng = SeedRandom(seed);
+    game->runTick = 0;
+
     game->state = GAME_RUNNING;
     game->score = 0;
     game->lives = MAX_LIVES;
     game->pipeSpawnTimer = 0.0f;
-    game->pipeCount = 0;
 
     InitBird(&game->bird);
 
-    for (int i = 0; i < PIPE_CAPACITY; i++) {
-        game->pipes[i].active = false;
-        game->pipes[i].scored = false;
-    }
-
+    StartCourse(&game->course, game->course.curve);
+    ClearPipes(&game->pipes);
     SpawnPipe(game);
 }
 
-void UnloadGame(Game *game) {
-    SaveSettings(&game->settings);
-    UnloadAssets(game);
+bool GameIsStatic(const Game *game) {
+    // The offset is cleared on the tick after the timer runs out
+    if (game->shakeTimer > 0.0f || game->shakeOffset.x != 0.0f || game->shakeOffset.y != 0.0f) return false;
+    return game->state == GAME_WAITING || game->state == GAME_PAUSED ||
+           game->state == GAME_SETTINGS || game->state == GAME_OVER;
 }
 
 // --- PIPES ---
 void SpawnPipe(Game *game) {
-    Pipe *pipe = NULL;
-    int foundIndex = -1;
-
-    for (int i = 0; i < PIPE_CAPACITY; i++) {
-        int checkIndex = (game->pipeCount + i) % PIPE_CAPACITY;
-        if (!game->pipes[checkIndex].active) {
-            pipe = &game->pipes[checkIndex];
-            foundIndex = checkIndex;
-            break;
-        }
-    }
+    PipeRing *ring = &game->pipes;
 
-    if (pipe == NULL) {
-        int overwriteIndex = game->pipeCount % PIPE_CAPACITY;
-        pipe = &game->pipes[overwriteIndex];
-        foundIndex = overwriteIndex;
+    // Grow rather than lose a live pipe; only if memory runs out does the oldest go
+    if (ring->count == ring->capacity && !ReservePipes(ring, ring->capacity * 2)) {
+        if (ring->capacity == 0) return;
+        ring->head = PipeSlot(ring, 1);
+        ring->count--;
     }
 
-    game->pipeCount = (foundIndex + 1) % PIPE_CAPACITY;
-
-    int gapSize = MIN_GAP_SIZE + rand() % (MAX_GAP_SIZE - MIN_GAP_SIZE + 1);
-    int minY = 60;
-    int maxY = SCREEN_HEIGHT - 60 - gapSize;
-    int gapY = minY + rand() % (maxY - minY + 1);
+    PipeSegment segment = NextCourseSegment(&game->course, &game->rng);
 
-    pipe->top = (Rectangle){ (float)SCREEN_WIDTH, 0.0f, PIPE_WIDTH, (float)gapY };
-    pipe->bottom = (Rectangle){
-        (float)SCREEN_WIDTH,
-        (float)(gapY + gapSize),
-        PIPE_WIDTH,
-        (float)(SCREEN_HEIGHT - (gapY + gapSize))
-    };
+    int s = PipeSlot(ring, ring->count);
+    ring->x[s] = (float)SCREEN_WIDTH;
+    ring->gapTop[s] = segment.gapTop;
+    ring->gapBottom[s] = segment.gapBottom;
+    ring->scored[s] = false;
 
-    pipe->active = true;
-    pipe->scored = false;
+    ring->count++;
+    ring->spawned++;
 }
 
 // --- UPDATE ---
-void UpdateGame(Game *game, float dt) {
+void UpdateGame(Game *game, const GameInput *input, GameEvents *events, float dt) {
     UpdateScreenShake(game, dt);
     
     // RESPAWN COUNTDOWN STATE
     if (game->state == GAME_RESPAWN_COUNTDOWN) {
+        game->runTick++;
         game->respawnTimer -= dt;
         
         if (game->respawnTimer <= 0.0f) {
@@ -201,34 +371,35 @@ void UpdateGame(Game *game, float dt) {
     
     // WAITING STATE
     if (game->state == GAME_WAITING) {
-        if (IsKeyPressed(KEY_SPACE) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            game->state = GAME_RUNNING;
-            BirdFlap(&game->bird);
-            PlaySound(game->sFlap);
-        }
-        if (IsKeyPressed(KEY_ESCAPE)) {
+        if (input->back) {
             game->state = GAME_SETTINGS;
+            return;
         }
-        return;
+        if (!input->flap) return;
+
+        // Fresh seeded run; the running tick below applies the starting flap
+        game->course.curve = game->settings.course;
+        ResetGame(game, NextRandom(&game->seedRng));
     }
 
     // GAME OVER STATE
     if (game->state == GAME_OVER) {
-        if (IsKeyPressed(KEY_SPACE) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            ResetGame(game);
-        }
-        if (IsKeyPressed(KEY_ESCAPE)) {
+        if (input->back) {
             game->state = GAME_WAITING;
+            return;
         }
-        return;
+        if (!input->flap) return;
+
+        game->course.curve = game->settings.course;
+        ResetGame(game, NextRandom(&game->seedRng));
     }
     
     // PAUSED STATE
     if (game->state == GAME_PAUSED) {
-        if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_P)) {
+        if (input->back || input->pause) {
             game->state = GAME_RUNNING;
         }
-        if (IsKeyPressed(KEY_S)) {
+        if (input->settings) {
             game->state = GAME_SETTINGS;
         }
         return;
@@ -237,29 +408,30 @@ void UpdateGame(Game *game, float dt) {
     // SETTINGS STATE
     if (game->state == GAME_SETTINGS) {
         // Volume controls
-        if (IsKeyDown(KEY_UP)) {
-            game->settings.sfxVolume += 0.01f;
+        if (input->volumeUp) {
+            game->settings.sfxVolume += VOLUME_RATE * dt;
             if (game->settings.sfxVolume > 1.0f) game->settings.sfxVolume = 1.0f;
-            SetSoundVolume(game->sFlap, game->settings.sfxVolume);
-            SetSoundVolume(game->sScore, game->settings.sfxVolume);
-            SetSoundVolume(game->sHit, game->settings.sfxVolume);
+            PushEvent(events, GAME_EVENT_VOLUME_CHANGED);
         }
-        if (IsKeyDown(KEY_DOWN)) {
-            game->settings.sfxVolume -= 0.01f;
+        if (input->volumeDown) {
+            game->settings.sfxVolume -= VOLUME_RATE * dt;
             if (game->settings.sfxVolume < 0.0f) game->settings.sfxVolume = 0.0f;
-            SetSoundVolume(game->sFlap, game->settings.sfxVolume);
-            SetSoundVolume(game->sScore, game->settings.sfxVolume);
-            SetSoundVolume(game->sHit, game->settings.sfxVolume);
+            PushEvent(events, GAME_EVENT_VOLUME_CHANGED);
         }
         
         // Toggle screen shake
-        if (IsKeyPressed(KEY_T)) {
+        if (input->toggleShake) {
             game->settings.screenShake = !game->settings.screenShake;
         }
+
+        // Cycle the course curve; it applies from the next run
+        if (input->changeCourse) {
+            game->settings.course = (game->settings.course + 1) % COURSE_CURVES;
+        }
         
         // Back to menu
-        if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_ENTER)) {
-            SaveSettings(&game->settings);
+        if (input->back || input->confirm) {
+            PushEvent(events, GAME_EVENT_SETTINGS_SAVED);
             game->state = GAME_WAITING;
         }
         return;
@@ -269,22 +441,71 @@ void UpdateGame(Game *game, float dt) {
     if (game->state != GAME_RUNNING) return;
     
     // Pause
-    if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_P)) {
+    if (input->back || input->pause) {
         game->state = GAME_PAUSED;
         return;
     }
 
-    if (IsKeyPressed(KEY_SPACE) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+    game->runTick++;
+
+    if (input->flap) {
         BirdFlap(&game->bird);
-        PlaySound(game->sFlap);
+        PushEvent(events, GAME_EVENT_FLAP);
+    }
+
+    float fromY = game->bird.position.y;
+    float travel = UpdateBird(&game->bird, dt);
+
+    Rectangle birdRect = BirdGetRect(&game->bird);
+    Rectangle birdFrom = birdRect;
+    birdFrom.y = fromY - game->bird.size.y * 0.5f;
+
+    PipeRing *ring = &game->pipes;
+    float scroll = PIPE_SPEED * dt;
+
+    // Seen from a pipe, the bird moves right by the scroll and along its own step
+    Vector2 motion = { scroll, game->bird.position.y - fromY };
+
+    // Earliest impact as a fraction of the step; above 1 means none. The bounds
+    // win a tie, as they did when everything was only tested at the end of the step.
+    float impact = 2.0f;
+    bool pipeHit = false;
+
+    float worldToi;
+    if (BirdSweepWorld(&game->bird, fromY, travel, &worldToi)) impact = worldToi;
+
+    // Broadphase: pipes are x-ordered, so stop at the first one that still starts right
+    // of the bird at the end of the step (1px margin for rounding in the sweep).
+    int candidates = 0;
+    for (; candidates < ring->count; candidates++) {
+        int s = PipeSlot(ring, candidates);
+        if (ring->x[s] - scroll >= birdRect.x + birdRect.width + 1.0f) break;
+
+        float toi;
+        if (SweepPipe(ring, s, birdFrom, motion, birdRect, &toi) && toi < impact) {
+            impact = toi;
+            pipeHit = true;
+        }
     }
 
-    UpdateBird(&game->bird, dt);
+    // Score every pipe whose centre the bird passed before any impact
+    for (int i = 0; i < candidates; i++) {
+        int s = PipeSlot(ring, i);
+        float x0 = ring->x[s];
+        float pipeCenterX = x0 - scroll + PIPE_WIDTH * 0.5f;
+
+        if (!ring->scored[s] && birdRect.x > pipeCenterX &&
+            x0 + PIPE_WIDTH * 0.5f - birdRect.x < impact * scroll) {
+            ring->scored[s] = true;
+            game->score++;
+            PushEvent(events, GAME_EVENT_SCORE);
+        }
+    }
 
-    if (BirdHitWorld(&game->bird)) {
+    if (impact <= 1.0f) {
         game->lives--;
         ApplyScreenShake(game, 10.0f, 0.3f);
-        PlaySound(game->sHit);
+        PushEvent(events, GAME_EVENT_HIT);
         
         if (game->lives <= 0) {
             game->state = GAME_OVER;
@@ -292,505 +513,29 @@ void UpdateGame(Game *game, float dt) {
                 game->highScore = game->score;
             }
         } else {
-            // Reset bird position and start countdown
+            // Reset bird (and the pipes, if one was hit), then start countdown
             InitBird(&game->bird);
+            if (pipeHit) {
+                ClearPipes(ring);
+                game->pipeSpawnTimer = 0.0f;
+                SpawnPipe(game);
+            }
             game->respawnTimer = 3.0f;
             game->state = GAME_RESPAWN_COUNTDOWN;
         }
         return;
     }
 
-    Rectangle birdRect = BirdGetRect(&game->bird);
-
-    for (int i = 0; i < PIPE_CAPACITY; i++) {
-        Pipe *p = &game->pipes[i];
-        if (!p->active) continue;
-
-        p->top.x    -= PIPE_SPEED * dt;
-        p->bottom.x -= PIPE_SPEED * dt;
-
-        if (p->top.x + PIPE_WIDTH < 0.0f) {
-            p->active = false;
-        }
-
-        if (CheckCollisionRecs(birdRect, p->top) ||
-            CheckCollisionRecs(birdRect, p->bottom)) {
-            game->lives--;
-            ApplyScreenShake(game, 10.0f, 0.3f);
-            PlaySound(game->sHit);
-            
-            if (game->lives <= 0) {
-                game->state = GAME_OVER;
-                if (game->score > game->highScore) {
-                    game->highScore = game->score;
-                }
-            } else {
-                // Reset bird and clear pipes, then start countdown
-                InitBird(&game->bird);
-                for (int j = 0; j < PIPE_CAPACITY; j++) {
-                    game->pipes[j].active = false;
-                }
-                game->pipeSpawnTimer = 0.0f;
-                SpawnPipe(game);
-                game->respawnTimer = 3.0f;
-                game->state = GAME_RESPAWN_COUNTDOWN;
-            }
-            return;
-        }
+    ScrollPipes(ring, scroll);
 
-        float pipeCenterX = p->top.x + PIPE_WIDTH * 0.5f;
-        if (!p->scored && birdRect.x > pipeCenterX) {
-            p->scored = true;
-            game->score++;
-            PlaySound(game->sScore);
-        }
+    while (ring->count > 0 && ring->x[ring->head] + PIPE_WIDTH < 0.0f) {
+        ring->head = PipeSlot(ring, 1);
+        ring->count--;
     }
 
     game->pipeSpawnTimer += dt;
-    if (game->pipeSpawnTimer >= PIPE_SPAWN_TIME) {
+    if (game->pipeSpawnTimer >= game->course.last.spacing) {
         game->pipeSpawnTimer = 0.0f;
         SpawnPipe(game);
     }
-}
-
-// --- DRAWING HELPERS ---
-static void DrawLives(const Game *game) {
-    Color heartRed = RED;
-    Color heartBlack = BLACK;
-    Color emptyGrey = (Color){ 100, 100, 100, 255 };
-    Color emptyDarkGrey = (Color){ 50, 50, 50, 255 };
-    
-    int pixelSize = 2; // Size of each "pixel" in the heart
-    int spacing = 40;
-    int startX = SCREEN_WIDTH - (MAX_LIVES * spacing) - 15;
-    int startY = 15;
-    
-    // Pixel heart pattern (16x14 grid)
-    // 1 = filled, 0 = empty
-    int heart[14][16] = {
-        {0,0,1,1,1,0,0,0,0,0,1,1,1,0,0,0},
-        {0,1,1,1,1,1,0,0,0,1,1,1,1,1,0,0},
-        {1,1,1,1,1,1,1,0,1,1,1,1,1,1,1,0},
-        {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
-        {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
-        {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0},
-        {0,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0},
-        {0,0,1,1,1,1,1,1,1,1,1,1,1,0,0,0},
-        {0,0,0,1,1,1,1,1,1,1,1,1,0,0,0,0},
-        {0,0,0,0,1,1,1,1,1,1,1,0,0,0,0,0},
-        {0,0,0,0,0,1,1,1,1,1,0,0,0,0,0,0},
-        {0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,1,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
-    };
-    
-    for (int i = 0; i < MAX_LIVES; i++) {
-        int baseX = startX + (i * spacing);
-        int baseY = startY;
-        
-        Color fillColor = (i < game->lives) ? heartRed : emptyGrey;
-        Color outlineColor = (i < game->lives) ? heartBlack : emptyDarkGrey;
-        
-        // Draw the pixel heart
-        for (int row = 0; row < 14; row++) {
-            for (int col = 0; col < 16; col++) {
-                if (heart[row][col] == 1) {
-                    int x = baseX + col * pixelSize;
-                    int y = baseY + row * pixelSize;
-                    DrawRectangle(x, y, pixelSize, pixelSize, fillColor);
-                }
-            }
-        }
-        
-        // Draw pixel outline/border for that retro look
-        for (int row = 0; row < 14; row++) {
-            for (int col = 0; col < 16; col++) {
-                if (heart[row][col] == 1) {
-                    int x = baseX + col * pixelSize;
-                    int y = baseY + row * pixelSize;
-                    
-                    // Check if this pixel is on the edge
-                    bool isEdge = false;
-                    
-                    // Check all 4 directions
-                    if (row == 0 || heart[row-1][col] == 0) isEdge = true; // top
-                    if (row == 13 || heart[row+1][col] == 0) isEdge = true; // bottom
-                    if (col == 0 || heart[row][col-1] == 0) isEdge = true; // left
-                    if (col == 15 || heart[row][col+1] == 0) isEdge = true; // right
-                    
-                    if (isEdge) {
-                        // Draw thin outline
-                        DrawRectangleLines(x, y, pixelSize, pixelSize, outlineColor);
-                    }
-                }
-            }
-        }
-    }
-}
-
-static void DrawRespawnCountdown(const Game *game) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
-    
-    bool useCustomFont = (game->font.texture.id > 0);
-    Color yellow = (Color){ 255, 230, 0, 255 };
-    Color shadow = (Color){ 0, 0, 0, 160 };
-    Vector2 shadowOffset = { 3, 3 };
-    
-    int countdown = (int)ceilf(game->respawnTimer);
-    const char *text;
-    
-    if (countdown == 3) text = "3";
-    else if (countdown == 2) text = "2";
-    else if (countdown == 1) text = "1";
-    else text = "GO!";
-    
-    float fontSize = 72.0f;
-    
-    if (useCustomFont) {
-        Vector2 textDim = MeasureTextEx(game->font, text, fontSize, 2.0f);
-        float textX = (SCREEN_WIDTH - textDim.x) / 2.0f;
-        float textY = (SCREEN_HEIGHT - textDim.y) / 2.0f;
-        
-        DrawTextEx(game->font, text,
-                   (Vector2){ textX + shadowOffset.x, textY + shadowOffset.y },
-                   fontSize, 2.0f, shadow);
-        DrawTextEx(game->font, text, (Vector2){ textX, textY }, fontSize, 2.0f, yellow);
-    } else {
-        int textWidth = MeasureText(text, (int)fontSize);
-        int textX = (SCREEN_WIDTH - textWidth) / 2;
-        int textY = SCREEN_HEIGHT / 2 - (int)fontSize / 2;
-        
-        DrawText(text, textX + (int)shadowOffset.x, textY + (int)shadowOffset.y, (int)fontSize, shadow);
-        DrawText(text, textX, textY, (int)fontSize, yellow);
-    }
-    
-    // Show remaining lives message
-    const char *lifeMsg = TextFormat("LIVES REMAINING: %d", game->lives);
-    float msgSize = 24.0f;
-    
-    if (useCustomFont) {
-        Vector2 msgDim = MeasureTextEx(game->font, lifeMsg, msgSize, 2.0f);
-        float msgX = (SCREEN_WIDTH - msgDim.x) / 2.0f;
-        DrawTextEx(game->font, lifeMsg, (Vector2){ msgX, SCREEN_HEIGHT / 2.0f + 80 }, msgSize, 2.0f, WHITE);
-    } else {
-        int msgWidth = MeasureText(lifeMsg, (int)msgSize);
-        int msgX = (SCREEN_WIDTH - msgWidth) / 2;
-        DrawText(lifeMsg, msgX, SCREEN_HEIGHT / 2 + 80, (int)msgSize, WHITE);
-    }
-}
-
-static void DrawWaitingScreen(const Game *game) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
-
-    Color uiColor = (Color){ 255, 230, 0, 255 };
-    Color shadow  = (Color){ 0, 0, 0, 160 };
-    Vector2 shadowOffset = { 2, 2 };
-
-    bool useCustomFont = (game->font.texture.id > 0);
-
-    const char *title = "FLAPPY BIRD";
-    float titleSize = 48.0f;
-    float titleX, titleY;
-    
-    if (useCustomFont) {
-        float titleSpacing = 2.0f;
-        Vector2 titleDim = MeasureTextEx(game->font, title, titleSize, titleSpacing);
-        titleX = (SCREEN_WIDTH - titleDim.x) / 2.0f;
-        titleY = SCREEN_HEIGHT / 2.0f - 100.0f;
-        
-        DrawTextEx(game->font, title,
-                   (Vector2){ titleX + shadowOffset.x, titleY + shadowOffset.y },
-                   titleSize, titleSpacing, shadow);
-        DrawTextEx(game->font, title, (Vector2){ titleX, titleY }, titleSize, titleSpacing, uiColor);
-    } else {
-        int titleWidth = MeasureText(title, (int)titleSize);
-        titleX = (SCREEN_WIDTH - titleWidth) / 2.0f;
-        titleY = SCREEN_HEIGHT / 2.0f - 100.0f;
-        
-        DrawText(title, (int)(titleX + shadowOffset.x), (int)(titleY + shadowOffset.y), (int)titleSize, shadow);
-        DrawText(title, (int)titleX, (int)titleY, (int)titleSize, uiColor);
-    }
-
-    const char *hint = "Press SPACE or Click to Start";
-    const char *settings = "Press ESC for Settings";
-    float hintSize = 24.0f;
-    float hintX, hintY;
-    
-    if (useCustomFont) {
-        float hintSpacing = 2.0f;
-        Vector2 hintDim = MeasureTextEx(game->font, hint, hintSize, hintSpacing);
-        hintX = (SCREEN_WIDTH - hintDim.x) / 2.0f;
-        hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
-        
-        DrawTextEx(game->font, hint, (Vector2){ hintX + 1, hintY + 1 }, hintSize, hintSpacing, shadow);
-        DrawTextEx(game->font, hint, (Vector2){ hintX, hintY }, hintSize, hintSpacing, WHITE);
-        
-        Vector2 settingsDim = MeasureTextEx(game->font, settings, 20.0f, hintSpacing);
-        float settingsX = (SCREEN_WIDTH - settingsDim.x) / 2.0f;
-        DrawTextEx(game->font, settings, (Vector2){ settingsX + 1, hintY + 41 }, 20.0f, hintSpacing, (Color){40, 40, 40, 255});
-        DrawTextEx(game->font, settings, (Vector2){ settingsX, hintY + 40 }, 20.0f, hintSpacing, (Color){200, 200, 200, 255});
-    } else {
-        int hintWidth = MeasureText(hint, (int)hintSize);
-        hintX = (SCREEN_WIDTH - hintWidth) / 2.0f;
-        hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
-        
-        DrawText(hint, (int)(hintX + 1), (int)(hintY + 1), (int)hintSize, shadow);
-        DrawText(hint, (int)hintX, (int)hintY, (int)hintSize, WHITE);
-        
-        int settingsWidth = MeasureText(settings, 20);
-        int settingsX = (SCREEN_WIDTH - settingsWidth) / 2;
-        DrawText(settings, settingsX + 1, (int)hintY + 41, 20, (Color){40, 40, 40, 255});
-        DrawText(settings, settingsX, (int)hintY + 40, 20, (Color){200, 200, 200, 255});
-    }
-}
-
-static void DrawGameOverScreen(const Game *game) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
-
-    Color uiColor = (Color){ 255, 230, 0, 255 };
-    Color shadow  = (Color){ 0, 0, 0, 160 };
-    Vector2 shadowOffset = { 2, 2 };
-
-    bool useCustomFont = (game->font.texture.id > 0);
-
-    const char *msg = "GAME OVER";
-    float fontSize = 48.0f;
-    float msgX, msgY;
-    
-    if (useCustomFont) {
-        float fontSpacing = 2.0f;
-        Vector2 msgSize = MeasureTextEx(game->font, msg, fontSize, fontSpacing);
-        msgX = (SCREEN_WIDTH - msgSize.x) / 2.0f;
-        msgY = SCREEN_HEIGHT / 2.0f - 60.0f;
-        
-        DrawTextEx(game->font, msg,
-                   (Vector2){ msgX + shadowOffset.x, msgY + shadowOffset.y },
-                   fontSize, fontSpacing, shadow);
-        DrawTextEx(game->font, msg, (Vector2){ msgX, msgY }, fontSize, fontSpacing, uiColor);
-    } else {
-        int msgWidth = MeasureText(msg, (int)fontSize);
-        msgX = (SCREEN_WIDTH - msgWidth) / 2.0f;
-        msgY = SCREEN_HEIGHT / 2.0f - 60.0f;
-        
-        DrawText(msg, (int)(msgX + shadowOffset.x), (int)(msgY + shadowOffset.y), (int)fontSize, shadow);
-        DrawText(msg, (int)msgX, (int)msgY, (int)fontSize, uiColor);
-    }
-
-    const char *hint = "Press SPACE or Click to Restart";
-    const char *menu = "Press ESC for Menu";
-    float hintSize = 24.0f;
-    float hintX, hintY;
-    
-    if (useCustomFont) {
-        float hintSpacing = 2.0f;
-        Vector2 hintSizeVec = MeasureTextEx(game->font, hint, hintSize, hintSpacing);
-        hintX = (SCREEN_WIDTH - hintSizeVec.x) / 2.0f;
-        hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
-        
-        DrawTextEx(game->font, hint, (Vector2){ hintX + 1, hintY + 1 }, hintSize, hintSpacing, shadow);
-        DrawTextEx(game->font, hint, (Vector2){ hintX, hintY }, hintSize, hintSpacing, WHITE);
-        
-        Vector2 menuDim = MeasureTextEx(game->font, menu, 20.0f, hintSpacing);
-        float menuX = (SCREEN_WIDTH - menuDim.x) / 2.0f;
-        DrawTextEx(game->font, menu, (Vector2){ menuX + 1, hintY + 41 }, 20.0f, hintSpacing, (Color){40, 40, 40, 255});
-        DrawTextEx(game->font, menu, (Vector2){ menuX, hintY + 40 }, 20.0f, hintSpacing, (Color){200, 200, 200, 255});
-    } else {
-        int hintWidth = MeasureText(hint, (int)hintSize);
-        hintX = (SCREEN_WIDTH - hintWidth) / 2.0f;
-        hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
-        
-        DrawText(hint, (int)(hintX + 1), (int)(hintY + 1), (int)hintSize, shadow);
-        DrawText(hint, (int)hintX, (int)hintY, (int)hintSize, WHITE);
-        
-        int menuWidth = MeasureText(menu, 20);
-        int menuX = (SCREEN_WIDTH - menuWidth) / 2;
-        DrawText(menu, menuX + 1, (int)hintY + 41, 20, (Color){40, 40, 40, 255});
-        DrawText(menu, menuX, (int)hintY + 40, 20, (Color){200, 200, 200, 255});
-    }
-}
-
-static void DrawPauseScreen(const Game *game) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.6f));
-    
-    bool useCustomFont = (game->font.texture.id > 0);
-    Color yellow = (Color){ 255, 230, 0, 255 };
-    Color lightGrey = (Color){ 200, 200, 200, 255 };
-    Color darkShadow = (Color){ 40, 40, 40, 255 };
-    
-    const char *title = "PAUSED";
-    const char *resume = "Press ESC or P to Resume";
-    const char *settings = "Press S for Settings";
-    
-    if (useCustomFont) {
-        Vector2 titleDim = MeasureTextEx(game->font, title, 48.0f, 2.0f);
-        float titleX = (SCREEN_WIDTH - titleDim.x) / 2.0f;
-        DrawTextEx(game->font, title, (Vector2){ titleX, SCREEN_HEIGHT / 2.0f - 50 }, 48.0f, 2.0f, yellow);
-        
-        Vector2 resumeDim = MeasureTextEx(game->font, resume, 24.0f, 2.0f);
-        float resumeX = (SCREEN_WIDTH - resumeDim.x) / 2.0f;
-        DrawTextEx(game->font, resume, (Vector2){ resumeX, SCREEN_HEIGHT / 2.0f + 20 }, 24.0f, 2.0f, WHITE);
-        
-        Vector2 settingsDim = MeasureTextEx(game->font, settings, 20.0f, 2.0f);
-        float settingsX = (SCREEN_WIDTH - settingsDim.x) / 2.0f;
-        DrawTextEx(game->font, settings, (Vector2){ settingsX + 1, SCREEN_HEIGHT / 2.0f + 61 }, 20.0f, 2.0f, darkShadow);
-        DrawTextEx(game->font, settings, (Vector2){ settingsX, SCREEN_HEIGHT / 2.0f + 60 }, 20.0f, 2.0f, lightGrey);
-    } else {
-        int titleWidth = MeasureText(title, 48);
-        DrawText(title, (SCREEN_WIDTH - titleWidth) / 2, SCREEN_HEIGHT / 2 - 50, 48, yellow);
-        
-        int resumeWidth = MeasureText(resume, 24);
-        DrawText(resume, (SCREEN_WIDTH - resumeWidth) / 2, SCREEN_HEIGHT / 2 + 20, 24, WHITE);
-        
-        int settingsWidth = MeasureText(settings, 20);
-        DrawText(settings, (SCREEN_WIDTH - settingsWidth) / 2 + 1, SCREEN_HEIGHT / 2 + 61, 20, darkShadow);
-        DrawText(settings, (SCREEN_WIDTH - settingsWidth) / 2, SCREEN_HEIGHT / 2 + 60, 20, lightGrey);
-    }
-}
-
-static void DrawSettingsScreen(const Game *game) {
-    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.8f));
-    
-    bool useCustomFont = (game->font.texture.id > 0);
-    Color yellow = (Color){ 255, 230, 0, 255 };
-    Color lightGrey = (Color){ 200, 200, 200, 255 };
-    Color darkShadow = (Color){ 40, 40, 40, 255 };
-    
-    const char *title = "SETTINGS";
-    const char *volumeText = TextFormat("SFX Volume: %.0f%%", game->settings.sfxVolume * 100);
-    const char *shakeText = TextFormat("Screen Shake: %s", game->settings.screenShake ? "ON" : "OFF");
-    const char *controls1 = "UP/DOWN - Adjust Volume";
-    const char *controls2 = "T - Toggle Screen Shake";
-    const char *back = "Press ESC or ENTER to Save & Exit";
-    
-    int yPos = 150;
-    
-    if (useCustomFont) {
-        Vector2 titleDim = MeasureTextEx(game->font, title, 48.0f, 2.0f);
-        float titleX = (SCREEN_WIDTH - titleDim.x) / 2.0f;
-        DrawTextEx(game->font, title, (Vector2){ titleX, 100 }, 48.0f, 2.0f, yellow);
-        
-        DrawTextEx(game->font, volumeText, (Vector2){ 100, yPos }, 24.0f, 2.0f, WHITE);
-        DrawTextEx(game->font, shakeText, (Vector2){ 100, yPos + 50 }, 24.0f, 2.0f, WHITE);
-        
-        DrawTextEx(game->font, controls1, (Vector2){ 101, yPos + 121 }, 18.0f, 2.0f, darkShadow);
-        DrawTextEx(game->font, controls1, (Vector2){ 100, yPos + 120 }, 18.0f, 2.0f, lightGrey);
-        
-        DrawTextEx(game->font, controls2, (Vector2){ 101, yPos + 151 }, 18.0f, 2.0f, darkShadow);
-        DrawTextEx(game->font, controls2, (Vector2){ 100, yPos + 150 }, 18.0f, 2.0f, lightGrey);
-        
-        Vector2 backDim = MeasureTextEx(game->font, back, 20.0f, 2.0f);
-        float backX = (SCREEN_WIDTH - backDim.x) / 2.0f;
-        DrawTextEx(game->font, back, (Vector2){ backX, SCREEN_HEIGHT - 80 }, 20.0f, 2.0f, YELLOW);
-    } else {
-        int titleWidth = MeasureText(title, 48);
-        DrawText(title, (SCREEN_WIDTH - titleWidth) / 2, 100, 48, yellow);
-        
-        DrawText(volumeText, 100, yPos, 24, WHITE);
-        DrawText(shakeText, 100, yPos + 50, 24, WHITE);
-        
-        DrawText(controls1, 101, yPos + 121, 18, darkShadow);
-        DrawText(controls1, 100, yPos + 120, 18, lightGrey);
-        
-        DrawText(controls2, 101, yPos + 151, 18, darkShadow);
-        DrawText(controls2, 100, yPos + 150, 18, lightGrey);
-        
-        int backWidth = MeasureText(back, 20);
-        DrawText(back, (SCREEN_WIDTH - backWidth) / 2, SCREEN_HEIGHT - 80, 20, YELLOW);
-    }
-    
-    // Volume bar
-    DrawRectangle(100, yPos + 25, 300, 10, DARKGRAY);
-    DrawRectangle(100, yPos + 25, (int)(300 * game->settings.sfxVolume), 10, GREEN);
-}
-
-// --- DRAW ---
-void DrawGame(const Game *game) {
-    // Apply screen shake offset
-    BeginMode2D((Camera2D){ game->shakeOffset, (Vector2){0, 0}, 0.0f, 1.0f });
-    
-    DrawTexture(game->texBg, 0, 0, WHITE);
-
-    // Pipe texture regions
-    Rectangle srcCap        = { 0, 0, PIPE_WIDTH, PIPE_CAP_HEIGHT };
-    Rectangle srcCapFlipped = { 0, PIPE_CAP_HEIGHT, PIPE_WIDTH, -PIPE_CAP_HEIGHT };
-
-    float pipeBodyHeight = game->texPipe.height - PIPE_CAP_HEIGHT;
-    Rectangle srcBody        = { 0, PIPE_CAP_HEIGHT, PIPE_WIDTH, pipeBodyHeight };
-    Rectangle srcBodyFlipped = { 0, game->texPipe.height, PIPE_WIDTH, -pipeBodyHeight };
-
-    // Draw pipes
-    for (int i = 0; i < PIPE_CAPACITY; i++) {
-        const Pipe *p = &game->pipes[i];
-        if (!p->active) continue;
-
-        float topBodyHeight = p->top.height - PIPE_CAP_HEIGHT;
-        if (topBodyHeight < 0) topBodyHeight = 0;
-
-        Rectangle dstTopBody = { p->top.x, p->top.y, PIPE_WIDTH, topBodyHeight };
-        DrawTexturePro(game->texPipe, srcBody, dstTopBody, (Vector2){0,0}, 0.0f, WHITE);
-
-        Rectangle dstTopCap = { p->top.x, p->top.y + topBodyHeight, PIPE_WIDTH, PIPE_CAP_HEIGHT };
-        DrawTexturePro(game->texPipe, srcCap, dstTopCap, (Vector2){0,0}, 0.0f, WHITE);
-
-        float bottomBodyHeight = p->bottom.height - PIPE_CAP_HEIGHT;
-        if (bottomBodyHeight < 0) bottomBodyHeight = 0;
-
-        Rectangle dstBottomCap = { p->bottom.x, p->bottom.y, PIPE_WIDTH, PIPE_CAP_HEIGHT };
-        DrawTexturePro(game->texPipe, srcCapFlipped, dstBottomCap, (Vector2){0,0}, 0.0f, WHITE);
-
-        Rectangle dstBottomBody = { p->bottom.x, p->bottom.y + PIPE_CAP_HEIGHT, PIPE_WIDTH, bottomBodyHeight };
-        DrawTexturePro(game->texPipe, srcBodyFlipped, dstBottomBody, (Vector2){0,0}, 0.0f, WHITE);
-    }
-
-    DrawBirdSprite(game);
-    
-    EndMode2D();
-
-    // UI (not affected by shake)
-    Color uiColor = (Color){ 255, 230, 0, 255 };
-    Color shadow  = (Color){ 0, 0, 0, 160 };
-    Vector2 shadowOffset = { 2, 2 };
-
-    bool useCustomFont = (game->font.texture.id > 0);
-    
-    const char *scoreStr = TextFormat("SCORE: %d", game->score);
-    const char *bestStr = TextFormat("BEST: %d", game->highScore);
-
-    if (useCustomFont) {
-        DrawTextEx(game->font, scoreStr, (Vector2){ 20 + shadowOffset.x, 20 + shadowOffset.y }, 32, 2, shadow);
-        DrawTextEx(game->font, scoreStr, (Vector2){ 20, 20 }, 32, 2, uiColor);
-
-        DrawTextEx(game->font, bestStr, (Vector2){ 20 + shadowOffset.x, 60 + shadowOffset.y }, 20, 2, shadow);
-        DrawTextEx(game->font, bestStr, (Vector2){ 20, 60 }, 20, 2, uiColor);
-    } else {
-        DrawText(scoreStr, 20 + (int)shadowOffset.x, 20 + (int)shadowOffset.y, 32, shadow);
-        DrawText(scoreStr, 20, 20, 32, uiColor);
-        
-        DrawText(bestStr, 20 + (int)shadowOffset.x, 60 + (int)shadowOffset.y, 20, shadow);
-        DrawText(bestStr, 20, 60, 20, uiColor);
-    }
-    
-    // Draw lives (hearts)
-    DrawLives(game);
-
-    // Overlays
-    if (game->state == GAME_WAITING) {
-        DrawWaitingScreen(game);
-    }
-
-    if (game->state == GAME_OVER) {
-        DrawGameOverScreen(game);
-    }
-    
-    if (game->state == GAME_PAUSED) {
-        DrawPauseScreen(game);
-    }
-    
-    if (game->state == GAME_SETTINGS) {
-        DrawSettingsScreen(game);
-    }
-    
-    if (game->state == GAME_RESPAWN_COUNTDOWN) {
-        DrawRespawnCountdown(game);
-    }
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "raylib.h"
+#include "raylib.h"    // Vector2/Rectangle only - the core never calls into raylib
 #include <stdbool.h>
 #include "player.h"   // brings in Bird
+#include "course.h"
+
+// The SIMD batch kernels round every multiply and add separately, and the scalar step has
+// to match them bit for bit (as do replays, trained brains and versus peers built on other
+// machines). Fused multiply-adds, which -march=native and GCC on ARM turn on, would round
+// once, so everything that steps a Game is built with -ffp-contract=off.
 
 // --- CONFIGURATION CONSTANTS ---
 #define SCREEN_WIDTH  800
@@ -14,9 +20,17 @@
 #define PIPE_SPAWN_TIME 2.0f
 #define MIN_GAP_SIZE    100
 #define MAX_GAP_SIZE    160
+#define PIPE_CAPACITY   8         // initial pipe ring size, doubles whenever it fills up
+#define SNAPSHOT_PIPES  8         // pipes a snapshot holds; no course has more than 6 alive
 
 #define MAX_LIVES       3
 
+#define SIM_TICK_RATE   120.0f    // fixed simulation steps per second
+#define SIM_DT          (1.0f / SIM_TICK_RATE)
+#define MAX_FRAME_TIME  0.25f     // longest frame fed to the accumulator
+
+#define MAX_GAME_EVENTS 32
+
 // --- ENUMS ---
 typedef enum GameState {
     GAME_WAITING,
@@ -27,42 +41,84 @@ typedef enum GameState {
     GAME_RESPAWN_COUNTDOWN
 } GameState;
 
+typedef enum GameEventType {
+    GAME_EVENT_FLAP,
+    GAME_EVENT_SCORE,
+    GAME_EVENT_HIT,
+    GAME_EVENT_VOLUME_CHANGED,
+    GAME_EVENT_SETTINGS_SAVED
+} GameEventType;
+
 // --- STRUCTURES ---
+// A pipe as bots and the renderer see it, built on demand from the ring
 typedef struct Pipe {
     Rectangle top;
     Rectangle bottom;
-    bool active;
     bool scored;
 } Pipe;
 
+// Live pipes in spawn order. Every pipe enters at the same x and scrolls at the same
+// speed, so spawn order is also x order: new pipes join the tail and pipes that leave
+// the screen drop off the head. Structure-of-arrays, one x per pipe.
+typedef struct PipeRing {
+    float *x;               // left edge, shared by the top and bottom halves
+    float *gapTop;          // bottom edge of the top half
+    float *gapBottom;       // top edge of the bottom half
+    bool *scored;
+    int head;               // slot of the oldest (leftmost) pipe
+    int count;
+    int capacity;           // power of two
+    unsigned int spawned;   // pipes ever pushed, gives every pipe a stable serial
+} PipeRing;
+
 typedef struct Settings {
     float musicVolume;
     float sfxVolume;
     bool screenShake;
+    CourseCurve course;     // layout of the next run
 } Settings;
 
+// One tick of player intent. The simulation never polls devices itself,
+// so the same core runs under the window, headless tools and bots.
+typedef struct GameInput {
+    bool flap;          // SPACE or left click
+    bool back;          // ESC
+    bool pause;         // P
+    bool settings;      // S
+    bool confirm;       // ENTER
+    bool toggleShake;   // T
+    bool changeCourse;  // C
+    bool volumeUp;      // UP (held)
+    bool volumeDown;    // DOWN (held)
+} GameInput;
+
+// Side effects produced by UpdateGame (sounds, saves) for the shell to act on
+typedef struct GameEvents {
+    GameEventType items[MAX_GAME_EVENTS];
+    int count;
+} GameEvents;
+
+// Pure simulation state - no GPU or audio handles live here
 typedef struct Game {
     GameState state;
+
+    // Determinism: every random draw comes from these streams, never rand()
+    unsigned int seed;      // seed of the current run
+    unsigned int rng;       // gameplay stream (pipe layout)
+    unsigned int seedRng;   // hands out the seed of each new run
+    unsigned int fxRng;     // cosmetic stream (screen shake)
+    int runTick;            // simulation ticks since the run started
+
     int score;
     int highScore;
     int lives;
 
     Bird bird;
 
-    Pipe pipes[16];
+    PipeRing pipes;         // heap storage: copy with CopyGame, release with FreeGame
+    Course course;          // generates the pipes; its curve is fixed for the run
     float pipeSpawnTimer;
-    int pipeCount;
 
-    Texture2D texBird;
-    Texture2D texPipe;
-    Texture2D texBg;
-
-    Sound sFlap;
-    Sound sScore;
-    Sound sHit;
-
-    Font font;
-    
     // Screen shake
     float shakeTimer;
     float shakeMagnitude;
@@ -75,20 +131,56 @@ typedef struct Game {
     Settings settings;
 } Game;
 
+// The whole simulation as plain bytes, with no pointers to follow: it saves and loads
+// with a copy and can be diffed word by word. A pipe sits in slot serial % SNAPSHOT_PIPES
+// from spawn to despawn, so pipes that didn't change diff to nothing.
+typedef struct GameSnapshot {
+    Game game;              // pipes keeps only count and spawned
+    float pipeX[SNAPSHOT_PIPES];
+    float pipeGapTop[SNAPSHOT_PIPES];
+    float pipeGapBottom[SNAPSHOT_PIPES];
+    bool pipeScored[SNAPSHOT_PIPES];
+} GameSnapshot;
+
 // --- FUNCTION PROTOTYPES ---
-void InitGame(Game *game);
-void UpdateGame(Game *game, float dt);
-void DrawGame(const Game *game);
-void UnloadGame(Game *game);
-void ResetGame(Game *game);
+// InitGame allocates the pipe ring; pair every call with FreeGame
+void InitGame(Game *game, unsigned int seed);
+void FreeGame(Game *game);
+// Deep copy that reuses dst's pipe storage; dst must be initialised or zeroed
+void CopyGame(Game *dst, const Game *src);
+// Keeps the newest SNAPSHOT_PIPES pipes, as CopyGame does when it can't grow
+void SaveGameSnapshot(GameSnapshot *snapshot, const Game *game);
+// Reuses the game's pipe storage; leaves the game untouched and returns false if that
+// had to grow and couldn't. The game must be initialised or zeroed.
+bool LoadGameSnapshot(Game *game, const GameSnapshot *snapshot);
+void UpdateGame(Game *game, const GameInput *input, GameEvents *events, float dt);
+// True on the menu, pause, settings and game over screens once any shake has died
+// out: until the next input, ticks leave everything that is drawn unchanged
+bool GameIsStatic(const Game *game);
+// Keeps course.curve: set it first to play a run on another curve
+void ResetGame(Game *game, unsigned int seed);
 void SpawnPipe(Game *game);
 
+// Swept AABB: does `from`, moving by `motion` over one step, touch the static `target`?
+// On a hit toi receives the first fraction of the step [0, 1] where they overlap.
+// Overlap is strict, as in CheckCollisionRecs: boxes that only touch don't collide.
+bool SweepRects(Rectangle from, Vector2 motion, Rectangle target, float *toi);
+
+// Pipes, indexed by ring position (0 = oldest/leftmost)
+int PipeSlot(const PipeRing *ring, int i);
+unsigned int PipeSerial(const PipeRing *ring, int i);
+Pipe GetPipe(const Game *game, int i);
+
+// Seeded random streams
+unsigned int SeedRandom(unsigned int seed);
+unsigned int NextRandom(unsigned int *state);
+int RandomRange(unsigned int *state, int min, int max);
+
 // Screen shake
 void ApplyScreenShake(Game *game, float magnitude, float duration);
 void UpdateScreenShake(Game *game, float dt);
 
 // Settings
-void SaveSettings(const Settings *settings);
-void LoadSettings(Settings *settings);
+void DefaultSettings(Settings *settings);
 
 #endif // GAME_H
\ No newline at end of file
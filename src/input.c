@@ -0,0 +1,147 @@
+// src/input.c
+#include "input.h"
+#include <string.h>
+
+#define INPUT_MOUSE_BUTTONS 3
+
+static double period = 1.0 / 60.0;     // seconds between vsyncs
+static double budget;                  // seconds of frame work to leave before the next vsync
+
+// Presses from every poll since the frame started
+static bool keyPressed[INPUT_MAX_KEYS];
+static bool mousePressed[INPUT_MOUSE_BUTTONS];
+
+// Flap presses waiting for their tick, oldest first, then waiting for their frame to show
+static double flapTimes[INPUT_MAX_FLAPS];
+static int flapCount;
+static double shownTimes[INPUT_MAX_FLAPS];
+static int shownCount;
+
+static bool latched;           // this frame's input was latched
+static double latchEnd;
+static double lastShown;       // when the last EndDrawing returned, ~ the last vsync
+
+static int statFlaps;
+static double statLatencySum, statLatencyLast, statLatencyMax;
+static int statMissed;
+static int statDropped;
+
+void InitInput(int refreshRate) {
+    if (refreshRate > 0) period = 1.0 / refreshRate;
+    budget = period * 0.5;      // until real frames have been measured
+}
+
+// --- SAMPLING ---
+static void PushFlap(double time) {
+    if (flapCount == INPUT_MAX_FLAPS) {
+        statDropped++;
+        return;
+    }
+    flapTimes[flapCount++] = time;
+}
+
+// Everything the last poll saw. A key pressed and released between two polls is still
+// in raylib's press queue, where IsKeyPressed would miss it.
+static void CollectPresses(double time) {
+    bool flap = false;
+    int key;
+    while ((key = GetKeyPressed()) != 0) {
+        if (key < INPUT_MAX_KEYS) keyPressed[key] = true;
+        if (key == INPUT_FLAP_KEY) flap = true;
+    }
+    for (int button = 0; button < INPUT_MOUSE_BUTTONS; button++) {
+        if (!IsMouseButtonPressed(button)) continue;
+        mousePressed[button] = true;
+        if (button == INPUT_FLAP_BUTTON) flap = true;
+    }
+    if (flap) PushFlap(time);
+}
+
+void SampleInput(bool latch) {
+    memset(keyPressed, 0, sizeof(keyPressed));
+    memset(mousePressed, 0, sizeof(mousePressed));
+    CollectPresses(GetTime());
+
+    // Wait out the part of the frame the work doesn't need, listening all the while
+    latched = latch && lastShown > 0.0;
+    if (latched) {
+        double deadline = lastShown + period - budget - INPUT_LATCH_MARGIN;
+        while (GetTime() + INPUT_POLL_INTERVAL <= deadline) {
+            WaitTime(INPUT_POLL_INTERVAL);
+            PollInputEvents();
+            CollectPresses(GetTime());
+        }
+    }
+    latchEnd = GetTime();
+}
+
+bool InputPressed(int key) {
+    return key >= 0 && key < INPUT_MAX_KEYS && keyPressed[key];
+}
+
+bool InputMousePressed(int button) {
+    return button >= 0 && button < INPUT_MOUSE_BUTTONS && mousePressed[button];
+}
+
+bool HasFlapPress(void) {
+    return flapCount > 0;
+}
+
+bool TakeFlapPress(double until, bool last) {
+    int taken = 0;
+    while (taken < flapCount && (last || flapTimes[taken] < until)) taken++;
+    if (taken == 0) return false;
+
+    for (int i = 0; i < taken && shownCount < INPUT_MAX_FLAPS; i++) {
+        shownTimes[shownCount++] = flapTimes[i];
+    }
+    flapCount -= taken;
+    memmove(flapTimes, flapTimes + taken, flapCount * sizeof(double));
+    return true;
+}
+
+// --- FRAME TIMING ---
+// The reserve follows the slowest recent frame, and grows when a latched frame
+// still misses its vsync
+void InputFrameSubmitted(void) {
+    if (!latched) return;
+    double work = GetTime() - latchEnd;
+    budget *= INPUT_BUDGET_DECAY;
+    if (work > budget) budget = work;
+}
+
+void InputFrameShown(void) {
+    double now = GetTime();
+    if (latched && now > lastShown + period * 1.5) {
+        statMissed++;
+        budget += INPUT_LATCH_MARGIN;
+    }
+    if (budget > period) budget = period;
+
+    for (int i = 0; i < shownCount; i++) {
+        double latency = (now - shownTimes[i]) * 1000.0;
+        statFlaps++;
+        statLatencySum += latency;
+        statLatencyLast = latency;
+        if (latency > statLatencyMax) statLatencyMax = latency;
+    }
+    shownCount = 0;
+    lastShown = now;
+}
+
+void GetInputStats(InputStats *stats) {
+    stats->flaps = statFlaps;
+    stats->latencyLast = statLatencyLast;
+    stats->latencyMean = (statFlaps > 0) ? statLatencySum / statFlaps : 0.0;
+    stats->latencyMax = statLatencyMax;
+    stats->budget = budget * 1000.0;
+    stats->missed = statMissed;
+    stats->dropped = statDropped;
+}
+
+void LogInputStats(void) {
+    InputStats stats;
+    GetInputStats(&stats);
+    TraceLog(LOG_INFO, "INPUT: %d flaps, press-to-flip latency avg %.1f ms, max %.1f ms; %d latched frames missed vsync, %d presses dropped",
+             stats.flaps, stats.latencyMean, stats.latencyMax, stats.missed, stats.dropped);
+}
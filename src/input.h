@@ -0,0 +1,54 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// --- INPUT CONSTANTS ---
+#define INPUT_FLAP_KEY          KEY_SPACE
+#define INPUT_FLAP_BUTTON       MOUSE_LEFT_BUTTON
+#define INPUT_MAX_KEYS          512     // raylib key codes are below this
+#define INPUT_MAX_FLAPS         16      // timestamped flap presses waiting for a tick
+#define INPUT_POLL_INTERVAL     0.001   // seconds between polls while latching
+#define INPUT_LATCH_MARGIN      0.002   // seconds left spare before the frame has to start
+#define INPUT_BUDGET_DECAY      0.98    // per frame, how fast the frame-work estimate forgets a spike
+
+// --- STRUCTURES ---
+// Press-to-flip latency runs from the poll that saw a flap press to the return of the
+// EndDrawing that first showed its tick, i.e. the buffer flip at vsync. Scan-out and
+// the display itself come on top; the time an event sat in the OS queue before a poll
+// is not visible to raylib.
+typedef struct InputStats {
+    int flaps;
+    double latencyLast, latencyMean, latencyMax;    // ms
+    double budget;          // ms of frame work reserved before vsync while latching
+    int missed;             // latched frames that missed their vsync
+    int dropped;            // flap presses lost to a full queue
+} InputStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Main thread only. Between frames the device is polled more than once, so presses are
+// collected from every poll here and read with InputPressed rather than IsKeyPressed.
+void InitInput(int refreshRate);
+
+// Once per frame, after the previous EndDrawing. Takes in what EndDrawing's poll saw;
+// with `latch`, keeps polling every INPUT_POLL_INTERVAL until just before the frame
+// has to be simulated and drawn to make the next vsync, so presses are stamped to the
+// millisecond and the frame sees as late an input as it can.
+void SampleInput(bool latch);
+bool InputPressed(int key);
+bool InputMousePressed(int button);
+bool HasFlapPress(void);
+
+// Pops the flap presses stamped before `until` (GetTime seconds) and reports whether
+// there were any; `last` takes every press left, so none wait past the frame's ticks.
+bool TakeFlapPress(double until, bool last);
+
+// Call just before EndDrawing and right after it returns
+void InputFrameSubmitted(void);
+void InputFrameShown(void);
+
+void GetInputStats(InputStats *stats);
+void LogInputStats(void);
+
+#endif // INPUT_H
@@ -0,0 +1,63 @@
+// src/loader.c
+#include "loader.h"
+#include <string.h>
+
+// --- WORKER ---
+static void PostLoad(AssetLoader *loader, AssetLoadKind kind, int index) {
+    unsigned int n = atomic_load_explicit(&loader->posted, memory_order_relaxed);
+    loader->queue[n] = (AssetLoad){ kind, index };
+    atomic_store_explicit(&loader->posted, n + 1, memory_order_release);
+}
+
+// The atlas goes first: it replaces the placeholders on screen. Sounds follow one by one.
+static void *LoadAssetsWorker(void *arg) {
+    AssetLoader *loader = arg;
+    AssetData *data = &loader->data;
+
+    loader->fromArchive = LoadAssetArchive(data, ASSET_ARCHIVE);
+    if (loader->fromArchive) {
+        PostLoad(loader, ASSET_LOAD_ATLAS, 0);
+        for (int i = 0; i < SOUND_COUNT; i++) PostLoad(loader, ASSET_LOAD_SOUND, i);
+        return NULL;
+    }
+
+    bool atlas = DecodeAtlasFiles(data, &loader->builtinFont);
+    PostLoad(loader, atlas ? ASSET_LOAD_ATLAS : ASSET_LOAD_FAILED, 0);
+
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        DecodeSoundFile(data, i);
+        PostLoad(loader, ASSET_LOAD_SOUND, i);
+    }
+    return NULL;
+}
+
+// --- MAIN THREAD ---
+void StartAssetLoader(AssetLoader *loader) {
+    memset(&loader->data, 0, sizeof(loader->data));
+    loader->fromArchive = false;
+    atomic_store(&loader->posted, 0);
+    loader->polled = 0;
+
+    loader->threadRunning = (pthread_create(&loader->thread, NULL, LoadAssetsWorker, loader) == 0);
+    if (!loader->threadRunning) LoadAssetsWorker(loader);
+}
+
+bool PollAssetLoader(AssetLoader *loader, AssetLoad *load) {
+    if (loader->polled == atomic_load_explicit(&loader->posted, memory_order_acquire)) return false;
+
+    *load = loader->queue[loader->polled++];
+    return true;
+}
+
+bool AssetLoaderDone(const AssetLoader *loader) {
+    return loader->polled == ASSET_QUEUE_SIZE;
+}
+
+void FinishAssetLoader(AssetLoader *loader) {
+    if (loader->threadRunning) {
+        pthread_join(loader->thread, NULL);
+        loader->threadRunning = false;
+    }
+    UnloadAssetData(&loader->data);
+    UnloadGlyphSet(&loader->builtinFont);
+}
@@ -0,0 +1,49 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "assets.h"
+
+// --- BACKGROUND LOADING ---
+// One completion for the atlas and one per sound, so a load never fills the queue
+#define ASSET_QUEUE_SIZE (1 + SOUND_COUNT)
+
+typedef enum AssetLoadKind {
+    ASSET_LOAD_ATLAS,       // data.atlas, regions and font are ready to upload
+    ASSET_LOAD_SOUND,       // data.sounds[index] is ready (its data is NULL if the file was missing)
+    ASSET_LOAD_FAILED       // no atlas could be built; keep what is on screen
+} AssetLoadKind;
+
+typedef struct AssetLoad {
+    AssetLoadKind kind;
+    int index;
+} AssetLoad;
+
+// Reads and decodes on a worker thread and hands each finished part to the main
+// thread through a single-producer/single-consumer completion queue. A part of
+// `data` belongs to the worker until its completion has been polled.
+typedef struct AssetLoader {
+    AssetData data;
+    GlyphSet builtinFont;   // stands in for a missing font.ttf
+    bool fromArchive;
+
+    AssetLoad queue[ASSET_QUEUE_SIZE];
+    _Atomic unsigned int posted;    // written by the worker only
+    unsigned int polled;            // main thread only
+
+    pthread_t thread;
+    bool threadRunning;
+} AssetLoader;
+
+// --- FUNCTION PROTOTYPES ---
+// Main thread. If no thread can be started the load runs to completion right here.
+void StartAssetLoader(AssetLoader *loader);
+// Main thread: the next finished part, if any
+bool PollAssetLoader(AssetLoader *loader, AssetLoad *load);
+bool AssetLoaderDone(const AssetLoader *loader);
+// Waits for the worker and releases everything the uploads didn't take over
+void FinishAssetLoader(AssetLoader *loader);
+
+#endif // LOADER_H
@@ -2,30 +2,511 @@
 
 #include "raylib.h"
 #include "game.h"
+#include "render.h"
+#include "replay.h"
+#include "brain.h"
+#include "profiler.h"
+#include "store.h"
+#include "input.h"
+#include "capture.h"
+#include "rewind.h"
+#include "versus.h"
+#include "net.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-int main(void) {
+#define REPLAY_FILE         "last_run.rpl"
+#define REPLAY_FAST_FORWARD 8.0f      // playback speed while F is held
+#define AUTOPILOT_FILE      "best.brain"  // written by tools/trainer.c
+#define PROFILE_TRACE_FILE  "profile.json"
+#define REWIND_SPEED        2         // ticks stepped back per tick while R is held
+
+// One profiler scope per state, so UpdateGame's time is split by the branch it ran
+static const char *const updateZones[] = {
+    [GAME_WAITING]           = "UpdateGame/Waiting",
+    [GAME_RUNNING]           = "UpdateGame/Running",
+    [GAME_OVER]              = "UpdateGame/Over",
+    [GAME_PAUSED]            = "UpdateGame/Paused",
+    [GAME_SETTINGS]          = "UpdateGame/Settings",
+    [GAME_RESPAWN_COUNTDOWN] = "UpdateGame/Countdown"
+};
+
+// Translate this frame's device state into the simulation's input struct
+static void PollGameInput(GameInput *input) {
+    input->flap        = InputPressed(INPUT_FLAP_KEY) || InputMousePressed(INPUT_FLAP_BUTTON);
+    input->back        = InputPressed(KEY_ESCAPE);
+    input->pause       = InputPressed(KEY_P);
+    input->settings    = InputPressed(KEY_S);
+    input->confirm     = InputPressed(KEY_ENTER);
+    input->toggleShake = InputPressed(KEY_T);
+    input->changeCourse = InputPressed(KEY_C);
+    input->volumeUp    = IsKeyDown(KEY_UP);
+    input->volumeDown  = IsKeyDown(KEY_DOWN);
+}
+
+// Fold this frame's input into the input waiting for the next tick. Presses
+// latch until a tick consumes them, so none are lost on frames with no tick.
+// Flaps are not merged: each goes to the tick its timestamp falls in (TakeFlapPress).
+static void MergeGameInput(GameInput *pending, const GameInput *polled) {
+    pending->back        |= polled->back;
+    pending->pause       |= polled->pause;
+    pending->settings    |= polled->settings;
+    pending->confirm     |= polled->confirm;
+    pending->toggleShake |= polled->toggleShake;
+    pending->changeCourse |= polled->changeCourse;
+    pending->volumeUp     = polled->volumeUp;
+    pending->volumeDown   = polled->volumeDown;
+}
+
+static bool HasGameInput(const GameInput *input) {
+    return input->flap || input->back || input->pause || input->settings || input->confirm ||
+           input->toggleShake || input->changeCourse || input->volumeUp || input->volumeDown;
+}
+
+// Presses apply to one tick only; held keys keep applying
+static void ConsumePressedInput(GameInput *pending) {
+    GameInput held = { 0 };
+    held.volumeUp   = pending->volumeUp;
+    held.volumeDown = pending->volumeDown;
+    *pending = held;
+}
+
+// Practice rewind: puts the run back REWIND_SPEED ticks, as far as the history goes. The
+// settings and best score are the player's, not the run's, so they stay. The history and
+// the recording are cut back to match, so the saved replay is still the run as played.
+static void RewindGame(Game *game, RewindBuffer *history, Replay *recording) {
+    int tick = game->runTick - REWIND_SPEED;
+    if (tick < history->firstTick) tick = history->firstTick;
+    if (tick >= game->runTick) return;
+
+    GameSnapshot snapshot;
+    Settings settings = game->settings;
+    int highScore = game->highScore;
+    if (!RewindLoad(history, tick, &snapshot) || !LoadGameSnapshot(game, &snapshot)) return;
+    game->settings = settings;
+    game->highScore = highScore;
+
+    RewindTruncate(history, tick);
+    ReplayRewind(recording, tick);
+}
+
+// Play sounds and persist settings requested by the simulation
+static void HandleGameEvents(const Game *game, Store *store, const GameEvents *events) {
+    for (int i = 0; i < events->count; i++) {
+        switch (events->items[i]) {
+            case GAME_EVENT_FLAP:           PlayMixerSound(SOUND_FLAP); break;
+            case GAME_EVENT_SCORE:          PlayMixerSound(SOUND_SCORE); break;
+            case GAME_EVENT_HIT:            PlayMixerSound(SOUND_HIT); break;
+            case GAME_EVENT_VOLUME_CHANGED: SetMixerVolume(game->settings.sfxVolume); break;
+            case GAME_EVENT_SETTINGS_SAVED: StoreSettings(store, &game->settings); break;
+        }
+    }
+}
+
+// --- VERSUS ---
+// A match against another process on this machine: the local bird against the peer's
+// ghost on the same course. Replays, rewind, the autopilot and the store's run history
+// stay out of it; none of them know about a second player. Returns on ESC or close.
+static void PlayVersus(NetLink *link, int side, Store *store, const Settings *settings, Assets *assets) {
+    VersusMatch *match = malloc(sizeof(VersusMatch));
+    if (match == NULL) return;
+
+    // The host picks the seed and course; the joiner takes them from its first packet
+    bool started = false;
+    Game prev[2];
+    InitGame(&prev[0], 0);
+    InitGame(&prev[1], 0);
+    if (side == 0) {
+        InitVersus(match, (unsigned int)time(NULL), settings->course, 0);
+        match->players[side].settings = *settings;
+        started = true;
+    }
+
+    unsigned char packet[NET_MAX_PACKET];
+    bool flapWaiting = false;   // pressed on a tick the match stalled on
+    float accumulator = 0.0f;
+    double frameClock = GetTime();
+    Color uiColor = (Color){ 255, 230, 0, 255 };
+
+    while (!WindowShouldClose()) {
+        ProfileBegin("Frame");
+        ProfileBegin("SampleInput");
+        SampleInput(started);
+        ProfileEnd();
+
+        double now = GetTime();
+        float frameTime = (float)(now - frameClock);
+        frameClock = now;
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        accumulator += frameTime;
+        MixerInputPolled();
+
+        ProfileBegin("NetReceive");
+        int size;
+        while ((size = NetReceive(link, packet, sizeof(packet))) > 0) {
+            if (!started) {
+                unsigned int seed;
+                CourseCurve course;
+                int from;
+                if (!ReadVersusHeader(packet, size, &seed, &course, &from) || from == side) continue;
+                InitVersus(match, seed, course, side);
+                match->players[side].settings = *settings;
+                started = true;
+            }
+            ReceiveVersusPacket(match, packet, size);
+        }
+        ProfileEnd();
+
+        // A tick refused for want of the peer's input is dropped rather than caught up
+        // later, so the side that is ahead slows down to meet the other
+        GameEvents events = { 0 };
+        ProfileBegin("Simulate");
+        double tickEnd = now - accumulator;
+        while (accumulator >= SIM_DT) {
+            tickEnd += SIM_DT;
+            bool flap = TakeFlapPress(tickEnd, accumulator < 2.0f * SIM_DT) || flapWaiting;
+            if (started) {
+                CopyGame(&prev[0], &match->players[0]);
+                CopyGame(&prev[1], &match->players[1]);
+                flapWaiting = !AdvanceVersus(match, flap, &events) && flap;
+            }
+            accumulator -= SIM_DT;
+        }
+        ProfileEnd();
+
+        // Inputs that arrived on a frame with no tick still correct the rival before drawing
+        if (started) {
+            ProfileBegin("Rollback");
+            SettleVersus(match);
+            ProfileEnd();
+            NetSend(link, packet, WriteVersusPacket(match, packet));
+            HandleGameEvents(&match->players[side], store, &events);
+        }
+        UpdateAssets(assets);
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        Vector2 status = { 20, SCREEN_HEIGHT - 30 };
+        if (!started || !match->connected) {
+            if (started) DrawGame(&prev[side], &match->players[side], accumulator / SIM_DT, assets);
+            DrawTextEx(assets->font, TextFormat("WAITING FOR RIVAL ON PORT %d", link->peerPort), status, 20, 2, uiColor);
+        } else {
+            int rival = 1 - side;
+            DrawVersus(&prev[side], &match->players[side], &prev[rival], &match->players[rival],
+                       accumulator / SIM_DT, assets);
+
+            // Higher score wins; on a tie, whoever lasted longer
+            const VersusStats *stats = &match->stats;
+            if (VersusFinished(match)) {
+                int mine = match->players[side].score;
+                int theirs = match->players[rival].score;
+                int lead = (mine != theirs) ? mine - theirs : match->overTick[side] - match->overTick[rival];
+                const char *result = (lead > 0) ? "YOU WIN" : (lead < 0) ? "YOU LOSE" : "DRAW";
+                DrawTextEx(assets->font, TextFormat("%s %d - %d   ESC TO LEAVE", result, mine, theirs), status, 20, 2, uiColor);
+            } else {
+                DrawTextEx(assets->font, TextFormat("ROLLBACKS %lld  DEEPEST %d  STALLS %lld",
+                           stats->rollbacks, stats->maxRollback, stats->stalls), status, 16, 1, uiColor);
+            }
+        }
+        int drawCalls = GetFrameDrawCalls();
+
+        InputFrameSubmitted();
+        ProfileBegin("EndDrawing");
+        EndDrawing();
+        ProfileEnd();
+        InputFrameShown();
+
+        ProfileEnd();
+        ProfileFrame(drawCalls);
+        if (InputPressed(KEY_ESCAPE)) break;
+    }
+
+    if (started) {
+        const VersusStats *stats = &match->stats;
+        TraceLog(LOG_INFO, "VERSUS: %lld ticks, %lld stalls, %lld rollbacks (%lld ticks re-simulated, deepest %d)",
+                 stats->ticks, stats->stalls, stats->rollbacks, stats->resimTicks, stats->maxRollback);
+        TraceLog(LOG_INFO, "VERSUS: Re-simulation %.1f us per rollback (max %.1f us), %lld of %lld state checks desynced",
+                 (stats->rollbacks > 0) ? stats->resimSeconds / stats->rollbacks * 1e6 : 0.0,
+                 stats->maxResimSeconds * 1e6, stats->desyncs, stats->checks);
+        TraceLog(LOG_INFO, "VERSUS: %lld packets sent, %lld received, %lld lost in the shim",
+                 link->stats.sent, link->stats.received, link->stats.lost);
+        FreeVersus(match);
+    }
+    FreeGame(&prev[0]);
+    FreeGame(&prev[1]);
+    free(match);
+}
+
+// Usage: flappy_bird [--software] [--capture out.y4m|prefix] [replay.rpl]
+//        flappy_bird --versus host|join port peerPort [--latency ms] [--jitter ms] [--loss %]
+//   replay.rpl  watch that run (hold F to fast-forward)
+//   --software  start on the CPU rasterizer (F5 switches backends at any time)
+//   --capture   record every frame; with a replay, render it at CAPTURE_FPS and quit at its end
+//   --versus    race another copy on 127.0.0.1; the host picks the course. The shim
+//               options delay and drop this side's outgoing packets.
+int main(int argc, char **argv) {
+    const char *capturePath = NULL;
+    const char *replayPath = NULL;
+    bool software = false;
+    int versusSide = -1;
+    int versusPort = 0;
+    int versusPeerPort = 0;
+    NetShim shim = { 0 };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) capturePath = argv[++i];
+        else if (strcmp(argv[i], "--software") == 0) software = true;
+        else if (strcmp(argv[i], "--versus") == 0 && i + 3 < argc) {
+            versusSide = (strcmp(argv[++i], "join") == 0) ? 1 : 0;
+            versusPort = atoi(argv[++i]);
+            versusPeerPort = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--latency") == 0 && i + 1 < argc) shim.latencyMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) shim.jitterMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc) shim.loss = (float)atof(argv[++i]) / 100.0f;
+        else replayPath = argv[i];
+    }
+    bool captureReplay = capturePath != NULL && replayPath != NULL;
+
+    // Gameplay runs at a fixed SIM_TICK_RATE, so rendering is free to follow vsync. A replay
+    // capture steps exactly 1/CAPTURE_FPS per frame instead, paced by the frame limiter.
+    if (!captureReplay) SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Flappy Bird");
-    SetTargetFPS(60);
+    if (captureReplay) SetTargetFPS(CAPTURE_FPS);
     
     // Disable ESC key to close window - we handle ESC ourselves
     SetExitKey(KEY_NULL);
 
+    // F3 shows frame statistics, F4 writes the recorded scopes as a Chrome trace
+    InitProfiler();
+    bool showProfiler = false;
+
+    // Static screens wait for input instead of redrawing; counts what that saves
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    InitPower(refreshRate);
+
+    // Presses are stamped as they are polled; during a run the frame starts as late as
+    // it can and still make vsync, listening for input until then
+    InitInput(refreshRate);
+
+    // Settings, lifetime stats and run history; written on the store's own thread
+    Store store;
+    OpenStore(&store);
+
     Game game;
-    InitGame(&game);
+    InitGame(&game, (unsigned int)time(NULL));
+    game.settings = store.settings;
+    game.highScore = store.stats.highScore;
 
-    while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
+    Assets assets;
+    ProfileBegin("LoadAssets");
+    LoadAssets(&assets, &game.settings);
+    ProfileEnd();
+    if (software) SetRenderBackend(&assets, RENDER_SOFTWARE);
+
+    // Every live run is recorded and written out when it ends
+    Replay recording = { 0 };
+    Replay playback = { 0 };
+    ReplayPlayer player = { 0 };
+    bool playing = false;
+
+    // Every tick of the current run, for the practice rewind on R
+    RewindBuffer history;
+    if (!InitRewind(&history, REWIND_BUDGET)) TraceLog(LOG_WARNING, "REWIND: No memory for the rewind buffer");
+    GameSnapshot snapshot;
+
+    // Optional trained autopilot, toggled with A
+    Brain brain;
+    bool haveBrain = LoadBrain(&brain, AUTOPILOT_FILE);
+    bool autopilot = false;
+
+    if (replayPath != NULL) {
+        if (LoadReplay(&playback, replayPath)) {
+            StartReplay(&player, &playback, &game);
+            playing = true;
+        } else {
+            TraceLog(LOG_WARNING, "REPLAY: Failed to load %s", replayPath);
+        }
+    }
+
+    // Frames are read back into a buffer pool and encoded on a background thread
+    bool capturing = false;
+    if (capturePath != NULL) {
+        int fps = captureReplay ? CAPTURE_FPS : (refreshRate > 0) ? refreshRate : POWER_DEFAULT_REFRESH;
+        capturing = StartCapture(capturePath, fps);
+        if (!capturing) TraceLog(LOG_WARNING, "CAPTURE: Failed to start capturing to %s", capturePath);
+    }
+
+    // A versus match takes the place of the solo loop for the whole session
+    bool quit = false;
+    if (versusSide >= 0) {
+        NetLink link;
+        if (OpenNetLink(&link, versusPort, versusPeerPort, &shim)) {
+            PlayVersus(&link, versusSide, &store, &game.settings, &assets);
+            CloseNetLink(&link);
+        } else {
+            TraceLog(LOG_WARNING, "VERSUS: Failed to bind 127.0.0.1:%d", versusPort);
+        }
+        quit = true;
+    }
+
+    Game prevGame = { 0 };
+    CopyGame(&prevGame, &game);
+    GameInput pending = { 0 };
+    float accumulator = 0.0f;
+    double frameClock = GetTime();
+    bool waited = false;        // the last frame ended waiting for input
+
+    while (!quit && !WindowShouldClose()) {
+        ProfileBegin("Frame");
+
+        bool live = game.state == GAME_RUNNING || game.state == GAME_RESPAWN_COUNTDOWN;
+        ProfileBegin("SampleInput");
+        SampleInput(live && !playing && !waited);
+        ProfileEnd();
+
+        // Timed here rather than with GetFrameTime, which lags a frame behind: a wait for
+        // input must not come back as catch-up ticks, so the frame after one runs one tick.
+        // Clamp long frames (window drag, hitch) so they cost catch-up ticks, not a life
+        double now = GetTime();
+        float frameTime = waited ? SIM_DT : (float)(now - frameClock);
+        if (captureReplay) frameTime = 1.0f / CAPTURE_FPS;
+        frameClock = now;
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        if (playing && IsKeyDown(KEY_F)) frameTime *= REPLAY_FAST_FORWARD;
+        accumulator += frameTime;
+
+        GameInput polled;
+        PollGameInput(&polled);
+        MixerInputPolled();
+        MergeGameInput(&pending, &polled);
+        bool shellInput = InputPressed(KEY_A) || InputPressed(KEY_F3) || InputPressed(KEY_F4) ||
+                          InputPressed(KEY_F5);
+        if (haveBrain && InputPressed(KEY_A)) autopilot = !autopilot;
+        if (InputPressed(KEY_F3)) showProfiler = !showProfiler;
+        if (InputPressed(KEY_F4)) {
+            if (SaveProfileTrace(PROFILE_TRACE_FILE)) TraceLog(LOG_INFO, "PROFILER: Trace written to %s", PROFILE_TRACE_FILE);
+            else TraceLog(LOG_WARNING, "PROFILER: Failed to write %s", PROFILE_TRACE_FILE);
+        }
+        if (InputPressed(KEY_F5)) {
+            SetRenderBackend(&assets, (assets.backend == RENDER_GPU) ? RENDER_SOFTWARE : RENDER_GPU);
+        }
 
         // Always call UpdateGame – it handles WAITING/RUNNING/OVER/PAUSED/SETTINGS
-        UpdateGame(&game, dt);
+        GameEvents events = { 0 };
+        ProfileBegin("Simulate");
+        double tickEnd = now - accumulator;     // the real time the simulation has reached
+        while (accumulator >= SIM_DT) {
+            // A flap lands on the tick its press falls in, not the first tick of the frame;
+            // the last tick takes any press still waiting
+            tickEnd += SIM_DT;
+            bool flap = TakeFlapPress(tickEnd, accumulator < 2.0f * SIM_DT);
+
+            CopyGame(&prevGame, &game);
+            bool rewinding = !playing && IsKeyDown(KEY_R) &&
+                             (game.state == GAME_RUNNING || game.state == GAME_RESPAWN_COUNTDOWN);
+            if (playing) {
+                ProfileBegin(updateZones[game.state]);
+                playing = StepReplay(&player, &game, &events);
+                ProfileEnd();
+            } else if (rewinding) {
+                ProfileBegin("Rewind");
+                RewindGame(&game, &history, &recording);
+                ProfileEnd();
+            } else {
+                pending.flap = flap;
+                if (autopilot && game.state == GAME_RUNNING) {
+                    pending.flap = BrainFlap(&brain, &game);
+                }
+                ProfileBegin(updateZones[game.state]);
+                UpdateGame(&game, &pending, &events, SIM_DT);
+                ProfileEnd();
+                ReplayRecordTick(&recording, &game, pending.flap);
+                if (game.runTick != prevGame.runTick) {
+                    ProfileBegin("Snapshot");
+                    SaveGameSnapshot(&snapshot, &game);
+                    RewindPush(&history, game.runTick, &snapshot);
+                    ProfileEnd();
+                }
+                if (game.state == GAME_OVER && prevGame.state != GAME_OVER) {
+                    SaveReplay(&recording, REPLAY_FILE);
+                    RunSummary run = { game.seed, game.score, game.runTick, (long long)time(NULL) };
+                    StoreRun(&store, &run);
+                }
+            }
+            ConsumePressedInput(&pending);
+            accumulator -= SIM_DT;
+        }
+        ProfileEnd();
+        UpdateAssets(&assets);
+        HandleGameEvents(&game, &store, &events);
+
+        // Low-power mode: on a static screen with no input, nothing loading and no overlay,
+        // the loop blocks until the next input event instead of redrawing every refresh.
+        // The first such frame is still drawn, so the screen is left showing the final state;
+        // after that, wakes that change nothing (mouse motion, releases) skip drawing too.
+        bool idle = !playing && !capturing && !showProfiler && !assets.loading && !shellInput &&
+                    events.count == 0 && !HasGameInput(&polled) && !HasGameInput(&pending) && !HasFlapPress() &&
+                    GameIsStatic(&game);
+        bool draw = !(idle && waited);
+        waited = idle;
+        if (idle) EnableEventWaiting();
+        else DisableEventWaiting();
+        PowerFrame(draw, idle);
+
+        if (!draw) {
+            ProfileEnd();
+            PollInputEvents();      // EndDrawing would have done this, and waits the same way
+            continue;
+        }
 
         BeginDrawing();
         ClearBackground(RAYWHITE);    // bg texture will cover this
-        DrawGame(&game);
+        DrawGame(&prevGame, &game, accumulator / SIM_DT, &assets);
+        if (autopilot) DrawTextEx(assets.font, "AUTOPILOT", (Vector2){ 20, SCREEN_HEIGHT - 30 }, 20, 2, (Color){ 255, 230, 0, 255 });
+        if (showProfiler) {
+            ProfileStats stats;
+            GetProfileStats(&stats);
+            DrawProfilerOverlay(&stats, &assets);
+        }
+        int drawCalls = GetFrameDrawCalls();
+
+        if (capturing) {
+            ProfileBegin("Capture");
+            CaptureFrame();
+            ProfileEnd();
+        }
+
+        // Includes the vsync wait
+        InputFrameSubmitted();
+        ProfileBegin("EndDrawing");
         EndDrawing();
+        ProfileEnd();
+        InputFrameShown();
+
+        ProfileEnd();
+        ProfileFrame(drawCalls);
+
+        // A replay capture is done once the run has played out
+        if (captureReplay && !playing) break;
     }
 
-    UnloadGame(&game);
+    StopCapture();
+    LogPowerStats();
+    LogInputStats();
+    RewindStats rewound;
+    GetRewindStats(&history, &rewound);
+    TraceLog(LOG_INFO, "REWIND: %.1f s of play held in %.2f of %.2f MB (%.1f bytes/tick)",
+             rewound.seconds, rewound.bytes / (1024.0 * 1024.0), rewound.budget / (1024.0 * 1024.0),
+             rewound.bytesPerTick);
+    FreeRewind(&history);
+    StoreSettings(&store, &game.settings);
+    CloseStore(&store);
+    FreeGame(&prevGame);
+    FreeGame(&game);
+    FreeReplay(&recording);
+    FreeReplay(&playback);
+    UnloadAssets(&assets);
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+// src/mixer.c
+#define _POSIX_C_SOURCE 200809L
+#include "mixer.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum MixerCommandKind {
+    MIXER_COMMAND_SOUND,    // samples/frameCount become the sound's clip
+    MIXER_COMMAND_PLAY,
+    MIXER_COMMAND_VOLUME
+} MixerCommandKind;
+
+typedef struct MixerCommand {
+    MixerCommandKind kind;
+    int sound;
+    float volume;
+    const float *samples;
+    unsigned int frameCount;
+    double inputTime;       // plays only
+} MixerCommand;
+
+typedef struct MixerVoice {
+    bool playing;
+    unsigned int position;  // next frame of the clip
+    unsigned int serial;    // play order, to find the oldest voice
+} MixerVoice;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- COMMAND QUEUE ---
+// head is written by the game thread only, tail by the audio thread only
+static MixerCommand queue[MIXER_QUEUE_SIZE];
+static _Atomic unsigned int queueHead;
+static _Atomic unsigned int queueTail;
+
+// --- AUDIO THREAD STATE ---
+static struct { const float *samples; unsigned int frameCount; } clips[SOUND_COUNT];
+static MixerVoice voices[SOUND_COUNT][MIXER_VOICES];
+static float mixVolume = 1.0f;
+static unsigned int playSerial;
+
+// Written by the audio thread, read by GetMixerStats
+static _Atomic unsigned int statPlays;
+static _Atomic unsigned int statStolen;
+static _Atomic unsigned long long statLatencySum;  // microseconds
+static _Atomic unsigned int statLatencyLast;
+static _Atomic unsigned int statLatencyMax;
+
+// --- GAME THREAD STATE ---
+static AudioStream stream;
+static bool mixerReady;
+static Wave ownedWaves[SOUND_COUNT];
+static float postedVolume = -1.0f;
+static double lastInputTime;
+static int droppedCommands;
+
+// --- AUDIO THREAD ---
+static void StartVoice(int sound, double inputTime, double audibleTime) {
+    if (clips[sound].samples == NULL) return;
+
+    // A free voice if there is one, else the one that has played longest
+    MixerVoice *voice = &voices[sound][0];
+    for (int i = 0; i < MIXER_VOICES; i++) {
+        MixerVoice *candidate = &voices[sound][i];
+        if (!candidate->playing) {
+            voice = candidate;
+            break;
+        }
+        if (candidate->serial - voice->serial > 0x80000000u) voice = candidate;
+    }
+    if (voice->playing) atomic_fetch_add_explicit(&statStolen, 1, memory_order_relaxed);
+    *voice = (MixerVoice){ true, 0, playSerial++ };
+
+    unsigned int latency = (unsigned int)((audibleTime - inputTime) * 1e6);
+    atomic_fetch_add_explicit(&statPlays, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&statLatencySum, latency, memory_order_relaxed);
+    atomic_store_explicit(&statLatencyLast, latency, memory_order_relaxed);
+    if (latency > atomic_load_explicit(&statLatencyMax, memory_order_relaxed)) {
+        atomic_store_explicit(&statLatencyMax, latency, memory_order_relaxed);
+    }
+}
+
+static void RunCommands(double audibleTime) {
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_acquire);
+
+    for (; tail != head; tail++) {
+        const MixerCommand *command = &queue[tail & (MIXER_QUEUE_SIZE - 1)];
+        switch (command->kind) {
+            case MIXER_COMMAND_SOUND:
+                clips[command->sound].samples = command->samples;
+                clips[command->sound].frameCount = command->frameCount;
+                break;
+            case MIXER_COMMAND_PLAY:
+                StartVoice(command->sound, command->inputTime, audibleTime);
+                break;
+            case MIXER_COMMAND_VOLUME:
+                mixVolume = command->volume;
+                break;
+        }
+    }
+    atomic_store_explicit(&queueTail, tail, memory_order_release);
+}
+
+// raylib's stream callback: 32-bit float mono, `frames` at a time
+static void MixAudio(void *bufferData, unsigned int frames) {
+    // What is mixed now is heard once the device has played this buffer out
+    RunCommands(NowSeconds() + (double)frames / MIXER_SAMPLE_RATE);
+
+    float *out = bufferData;
+    memset(out, 0, frames * sizeof(float));
+
+    for (int sound = 0; sound < SOUND_COUNT; sound++) {
+        const float *samples = clips[sound].samples;
+        unsigned int frameCount = clips[sound].frameCount;
+
+        for (int i = 0; i < MIXER_VOICES; i++) {
+            MixerVoice *voice = &voices[sound][i];
+            if (!voice->playing) continue;
+
+            unsigned int count = frameCount - voice->position;
+            if (count > frames) count = frames;
+            const float *src = samples + voice->position;
+            for (unsigned int f = 0; f < count; f++) out[f] += src[f];
+
+            voice->position += count;
+            if (voice->position >= frameCount) voice->playing = false;
+        }
+    }
+
+    for (unsigned int f = 0; f < frames; f++) {
+        float sample = out[f] * mixVolume;
+        out[f] = (sample > 1.0f) ? 1.0f : (sample < -1.0f) ? -1.0f : sample;
+    }
+}
+
+// --- GAME THREAD ---
+// Never waits: a command that finds the queue full is dropped and counted
+static bool PostCommand(const MixerCommand *command) {
+    if (!mixerReady) return false;
+
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_acquire);
+    if (head - tail == MIXER_QUEUE_SIZE) {
+        droppedCommands++;
+        return false;
+    }
+
+    queue[head & (MIXER_QUEUE_SIZE - 1)] = *command;
+    atomic_store_explicit(&queueHead, head + 1, memory_order_release);
+    return true;
+}
+
+void InitMixer(void) {
+    if (!IsAudioDeviceReady()) return;
+
+    SetAudioStreamBufferSizeDefault(MIXER_BUFFER_FRAMES);
+    stream = LoadAudioStream(MIXER_SAMPLE_RATE, 32, 1);
+    SetAudioStreamCallback(stream, MixAudio);
+    PlayAudioStream(stream);
+    mixerReady = true;
+}
+
+// Unloading the stream detaches the callback, so the clips can be freed after it
+void CloseMixer(void) {
+    if (mixerReady) {
+        UnloadAudioStream(stream);
+
+        MixerStats stats;
+        GetMixerStats(&stats);
+        TraceLog(LOG_INFO, "MIXER: %d plays, input-to-audio latency avg %.1f ms, max %.1f ms, %d cut off, %d commands dropped",
+                 stats.plays, stats.latencyMean, stats.latencyMax, stats.stolen, stats.dropped);
+    }
+    mixerReady = false;
+
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        UnloadWave(ownedWaves[i]);
+        ownedWaves[i] = (Wave){ 0 };
+    }
+}
+
+void SetMixerSound(SoundId sound, Wave wave) {
+    if (!mixerReady || ownedWaves[sound].data != NULL) return;
+
+    Wave clip = WaveCopy(wave);
+    WaveFormat(&clip, MIXER_SAMPLE_RATE, 32, 1);
+
+    MixerCommand command = { MIXER_COMMAND_SOUND, sound, 0.0f, clip.data, clip.frameCount, 0.0 };
+    if (PostCommand(&command)) ownedWaves[sound] = clip;
+    else UnloadWave(clip);
+}
+
+void PlayMixerSound(SoundId sound) {
+    MixerCommand command = { MIXER_COMMAND_PLAY, sound, 0.0f, NULL, 0, lastInputTime };
+    PostCommand(&command);
+}
+
+// Held volume keys change the volume every tick; only real changes reach the queue
+void SetMixerVolume(float volume) {
+    if (volume == postedVolume) return;
+
+    MixerCommand command = { MIXER_COMMAND_VOLUME, 0, volume, NULL, 0, 0.0 };
+    if (PostCommand(&command)) postedVolume = volume;
+}
+
+void MixerInputPolled(void) {
+    lastInputTime = NowSeconds();
+}
+
+void GetMixerStats(MixerStats *stats) {
+    unsigned int plays = atomic_load_explicit(&statPlays, memory_order_relaxed);
+    unsigned long long sum = atomic_load_explicit(&statLatencySum, memory_order_relaxed);
+
+    stats->plays = (int)plays;
+    stats->latencyLast = atomic_load_explicit(&statLatencyLast, memory_order_relaxed) / 1000.0;
+    stats->latencyMean = (plays > 0) ? sum / 1000.0 / plays : 0.0;
+    stats->latencyMax = atomic_load_explicit(&statLatencyMax, memory_order_relaxed) / 1000.0;
+    stats->stolen = (int)atomic_load_explicit(&statStolen, memory_order_relaxed);
+    stats->dropped = droppedCommands;
+}
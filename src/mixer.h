@@ -0,0 +1,40 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "assets.h"
+
+// --- MIXER CONSTANTS ---
+#define MIXER_SAMPLE_RATE   44100
+#define MIXER_BUFFER_FRAMES 512     // per audio callback, ~11.6 ms
+#define MIXER_VOICES        4       // overlapping plays of one sound; the oldest is cut off
+#define MIXER_QUEUE_SIZE    64      // commands in flight to the audio thread (power of two)
+
+// --- STRUCTURES ---
+// Latency runs from the input poll before a play to the moment its first sample
+// leaves the mixer, plus one callback buffer for the device to play it out.
+typedef struct MixerStats {
+    int plays;
+    double latencyLast, latencyMean, latencyMax;    // ms
+    int stolen;             // plays that cut off the oldest voice of their sound
+    int dropped;            // commands lost to a full queue
+} MixerStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Sounds are mixed in raylib's audio callback on the audio thread. The game thread only
+// posts commands to a lock-free single-producer/single-consumer queue and never waits
+// on the device; every function here is for the game thread.
+void InitMixer(void);       // after InitAudioDevice
+void CloseMixer(void);      // before CloseAudioDevice
+
+// Converts the wave to the mixer's format; the mixer owns the copy
+void SetMixerSound(SoundId sound, Wave wave);
+void PlayMixerSound(SoundId sound);
+void SetMixerVolume(float volume);
+
+// Marks the input poll that any plays posted after it respond to
+void MixerInputPolled(void);
+void GetMixerStats(MixerStats *stats);
+
+#endif // MIXER_H
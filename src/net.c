@@ -0,0 +1,150 @@
+// src/net.c
+#define _POSIX_C_SOURCE 200809L
+#include "net.h"
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #define NET_INVALID ((intptr_t)INVALID_SOCKET)
+    #define CloseSocket(s) closesocket((SOCKET)(s))
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #define NET_INVALID ((intptr_t)-1)
+    #define CloseSocket(s) close((int)(s))
+#endif
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static struct sockaddr_in LoopbackAddress(int port) {
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons((unsigned short)port);
+    return address;
+}
+
+// xorshift32, as in game.c; the shim's draws never touch the game's streams
+static unsigned int NextShimRandom(NetLink *link) {
+    unsigned int x = link->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    link->rng = x;
+    return x;
+}
+
+static float ShimUniform(NetLink *link) {
+    return (float)(NextShimRandom(link) >> 8) / 16777216.0f;
+}
+
+// --- LINK ---
+bool OpenNetLink(NetLink *link, int port, int peerPort, const NetShim *shim) {
+    memset(link, 0, sizeof(*link));
+    link->socket = NET_INVALID;
+    link->peerPort = (unsigned short)peerPort;
+    if (shim != NULL) link->shim = *shim;
+    link->rng = 0x9E3779B9u ^ (unsigned int)port;
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) return false;
+    u_long nonBlocking = 1;
+    bool ok = ioctlsocket(s, FIONBIO, &nonBlocking) == 0;
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s < 0) return false;
+    bool ok = fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    link->socket = (intptr_t)s;
+
+    struct sockaddr_in local = LoopbackAddress(port);
+    if (!ok || bind(s, (struct sockaddr *)&local, sizeof(local)) != 0) {
+        CloseNetLink(link);
+        return false;
+    }
+    return true;
+}
+
+void CloseNetLink(NetLink *link) {
+    if (link->socket == NET_INVALID) return;
+    CloseSocket(link->socket);
+    link->socket = NET_INVALID;
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+// --- SENDING ---
+static void SendNow(NetLink *link, const void *data, int size) {
+    struct sockaddr_in peer = LoopbackAddress(link->peerPort);
+    if (sendto(link->socket, data, size, 0, (struct sockaddr *)&peer, sizeof(peer)) == size) link->stats.sent++;
+}
+
+static void SendDue(NetLink *link) {
+    double now = NowSeconds();
+    for (int i = 0; i < link->queued;) {
+        if (link->queue[i].due > now) {
+            i++;
+            continue;
+        }
+        SendNow(link, link->queue[i].data, link->queue[i].size);
+        link->queue[i] = link->queue[--link->queued];
+    }
+}
+
+void NetSend(NetLink *link, const void *data, int size) {
+    if (link->socket == NET_INVALID || size <= 0 || size > NET_MAX_PACKET) return;
+
+    const NetShim *shim = &link->shim;
+    if (shim->loss > 0.0f && ShimUniform(link) < shim->loss) {
+        link->stats.lost++;
+        return;
+    }
+    if (shim->latencyMs <= 0 && shim->jitterMs <= 0) {
+        SendNow(link, data, size);
+        return;
+    }
+    if (link->queued == NET_SHIM_QUEUE) {
+        link->stats.overflowed++;
+        return;
+    }
+
+    float delay = (float)shim->latencyMs + (ShimUniform(link) * 2.0f - 1.0f) * (float)shim->jitterMs;
+    NetPacket *packet = &link->queue[link->queued++];
+    packet->due = NowSeconds() + ((delay > 0.0f) ? delay : 0.0f) * 0.001;
+    packet->size = size;
+    memcpy(packet->data, data, (size_t)size);
+}
+
+// --- RECEIVING ---
+int NetReceive(NetLink *link, void *buffer, int capacity) {
+    if (link->socket == NET_INVALID) return 0;
+    SendDue(link);
+
+    // Anything not from the peer's port is someone else's
+    for (;;) {
+        struct sockaddr_in from;
+#if defined(_WIN32)
+        int fromSize = sizeof(from);
+#else
+        socklen_t fromSize = sizeof(from);
+#endif
+        int size = (int)recvfrom(link->socket, buffer, capacity, 0, (struct sockaddr *)&from, &fromSize);
+        if (size <= 0) return 0;
+        if (from.sin_port != htons(link->peerPort) || from.sin_addr.s_addr != htonl(INADDR_LOOPBACK)) continue;
+        link->stats.received++;
+        return size;
+    }
+}
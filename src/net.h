@@ -0,0 +1,56 @@
+#ifndef NET_H
+#define NET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Plain UDP between two processes on 127.0.0.1. Kept apart from game.h: on Windows the
+// socket headers pull in windows.h, which clashes with raylib.h.
+
+// --- NET CONSTANTS ---
+#define NET_MAX_PACKET  256
+#define NET_SHIM_QUEUE  256     // packets the shim can hold back at once; more are lost
+
+// --- STRUCTURES ---
+// An artificial bad network in front of the real one. Every packet sent is lost with
+// probability `loss`, or else held back for latency +- jitter milliseconds. Jitter can
+// reorder packets, as a real network does.
+typedef struct NetShim {
+    int latencyMs;
+    int jitterMs;
+    float loss;             // 0..1
+} NetShim;
+
+typedef struct NetStats {
+    long long sent;         // handed to the socket
+    long long received;
+    long long lost;         // dropped by the shim
+    long long overflowed;   // dropped because the shim queue was full
+} NetStats;
+
+typedef struct NetPacket {
+    double due;
+    int size;
+    unsigned char data[NET_MAX_PACKET];
+} NetPacket;
+
+typedef struct NetLink {
+    intptr_t socket;
+    unsigned short peerPort;
+    NetShim shim;
+    unsigned int rng;
+    NetPacket queue[NET_SHIM_QUEUE];    // unordered; each goes out once it is due
+    int queued;
+    NetStats stats;
+} NetLink;
+
+// --- FUNCTION PROTOTYPES ---
+// Binds 127.0.0.1:port and sends to 127.0.0.1:peerPort. shim may be NULL for none.
+bool OpenNetLink(NetLink *link, int port, int peerPort, const NetShim *shim);
+void CloseNetLink(NetLink *link);
+// Never blocks; the shim decides when, and whether, the packet leaves
+void NetSend(NetLink *link, const void *data, int size);
+// Sends what the shim has due, then returns the size of one waiting packet, or 0
+int NetReceive(NetLink *link, void *buffer, int capacity);
+
+#endif // NET_H
@@ -13,13 +13,14 @@ void InitBird(Bird *bird) {
     bird->frameTimer = 0.0f;
 }
 
-void UpdateBird(Bird *bird, float dt) {
+float UpdateBird(Bird *bird, float dt) {
     // Gravity
     bird->velocity += bird->acceleration * dt;
-    if (bird->velocity > 350.0f) bird->velocity = 350.0f;
+    if (bird->velocity > MAX_FALL_SPEED) bird->velocity = MAX_FALL_SPEED;
 
     // Position
-    bird->position.y += bird->velocity * dt;
+    float travel = bird->velocity * dt;
+    bird->position.y += travel;
 
     // Tilt based on velocity
     bird->rotation = bird->velocity * 0.06f;
@@ -31,6 +32,8 @@ void UpdateBird(Bird *bird, float dt) {
         bird->position.y = bird->size.y * 0.5f;
         bird->velocity = 0.0f;
     }
+
+    return travel;
 }
 
 void BirdFlap(Bird *bird) {
@@ -45,6 +48,23 @@ bool BirdHitWorld(const Bird *bird) {
     return false;
 }
 
+// Velocity is constant within a step, so the bird's edges move linearly and the
+// bounds are reached at a simple fraction of the travel
+bool BirdSweepWorld(const Bird *bird, float fromY, float travel, float *toi) {
+    if (!BirdHitWorld(bird)) return false;
+
+    float halfH = bird->size.y * 0.5f;
+    float t = 1.0f;
+    if (travel < 0.0f) {
+        t = (fromY - halfH) / -travel;
+    } else if (travel > 0.0f) {
+        t = ((float)SCREEN_HEIGHT - (fromY + halfH)) / travel;
+    }
+
+    *toi = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+    return true;
+}
+
 Rectangle BirdGetRect(const Bird *bird) {
     return (Rectangle){
         bird->position.x - bird->size.x * 0.5f,
@@ -52,35 +72,4 @@ Rectangle BirdGetRect(const Bird *bird) {
         bird->size.x,
         bird->size.y
     };
-}
-
-// Draw using ENTIRE bird.png as a single frame (no sprite sheet)
-void DrawBirdSprite(const Game *game) {
-    const Bird *bird = &game->bird;
-
-    Rectangle sourceRec = {
-        0.0f,
-        0.0f,
-        (float)game->texBird.width,
-        (float)game->texBird.height
-    };
-
-    Rectangle destRec = {
-        bird->position.x,
-        bird->position.y,
-        bird->size.x,
-        bird->size.y
-    };
-
-    Vector2 origin = { bird->size.x * 0.5f, bird->size.y * 0.5f };
-    float angle = bird->rotation;
-
-    DrawTexturePro(
-        game->texBird,
-        sourceRec,
-        destRec,
-        origin,
-        angle,
-        WHITE
-    );
 }
\ No newline at end of file
@@ -7,12 +7,10 @@
 // --- BIRD CONSTANTS ---
 #define GRAVITY        1000.0f
 #define FLAP_STRENGTH  -350.0f
+#define MAX_FALL_SPEED 350.0f
 #define BIRD_WIDTH     34
 #define BIRD_HEIGHT    24
 
-// Forward declaration of Game (for DrawBirdSprite signature)
-typedef struct Game Game;
-
 // --- BIRD STRUCTURE ---
 typedef struct Bird {
     Vector2 position;
@@ -26,10 +24,13 @@ typedef struct Bird {
 
 // --- FUNCTION PROTOTYPES ---
 void InitBird(Bird *bird);
-void UpdateBird(Bird *bird, float dt);
+// Returns how far the bird moved this step before the ceiling clamp
+float UpdateBird(Bird *bird, float dt);
 void BirdFlap(Bird *bird);
 bool BirdHitWorld(const Bird *bird);
+// BirdHitWorld for a step that started at fromY and moved `travel`; on a hit, toi
+// receives the fraction of the step [0, 1] at which the floor or ceiling was reached
+bool BirdSweepWorld(const Bird *bird, float fromY, float travel, float *toi);
 Rectangle BirdGetRect(const Bird *bird);
-void DrawBirdSprite(const Game *game);
 
 #endif // PLAYER_H
\ No newline at end of file
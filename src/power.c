@@ -0,0 +1,70 @@
+// src/power.c
+#define _POSIX_C_SOURCE 200809L
+#include "power.h"
+#include "raylib.h"
+#include <time.h>
+
+static double NowSeconds(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int refresh = POWER_DEFAULT_REFRESH;
+static double lastWall;
+static double lastCpu;
+static bool lastWaiting;
+
+static long long framesDrawn;
+static double idleRefreshes;    // refreshes the display showed during idle time
+static long long idleDrawn;
+static double idleSeconds, idleCpu;
+static double activeSeconds, activeCpu;
+
+void InitPower(int refreshRate) {
+    refresh = (refreshRate > 0) ? refreshRate : POWER_DEFAULT_REFRESH;
+    lastWall = NowSeconds(CLOCK_MONOTONIC);
+    lastCpu = NowSeconds(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+// Each interval belongs to the frame that opened it: if that frame went on to wait,
+// the interval holds the wait and the work of the frame the wait ended in.
+void PowerFrame(bool drawn, bool waiting) {
+    double wall = NowSeconds(CLOCK_MONOTONIC);
+    double cpu = NowSeconds(CLOCK_PROCESS_CPUTIME_ID);
+
+    if (lastWaiting) {
+        idleSeconds += wall - lastWall;
+        idleCpu += cpu - lastCpu;
+        idleRefreshes += (wall - lastWall) * refresh;
+        if (drawn) idleDrawn++;
+    } else {
+        activeSeconds += wall - lastWall;
+        activeCpu += cpu - lastCpu;
+    }
+    if (drawn) framesDrawn++;
+
+    lastWall = wall;
+    lastCpu = cpu;
+    lastWaiting = waiting;
+}
+
+void GetPowerStats(PowerStats *stats) {
+    long long skipped = (long long)idleRefreshes - idleDrawn;
+
+    stats->framesDrawn = framesDrawn;
+    stats->framesSkipped = (skipped > 0) ? skipped : 0;
+    stats->idleSeconds = idleSeconds;
+    stats->idleCpu = idleCpu;
+    stats->activeCpuRate = (activeSeconds > 0.0) ? activeCpu / activeSeconds : 0.0;
+    stats->cpuSaved = idleSeconds * stats->activeCpuRate - idleCpu;
+    if (stats->cpuSaved < 0.0) stats->cpuSaved = 0.0;
+}
+
+void LogPowerStats(void) {
+    PowerStats stats;
+    GetPowerStats(&stats);
+    TraceLog(LOG_INFO, "POWER: %lld frames drawn, %lld skipped over %.1f s idle; idle used %.2f s CPU, saving ~%.2f s at the active rate of %.1f%%",
+             stats.framesDrawn, stats.framesSkipped, stats.idleSeconds, stats.idleCpu,
+             stats.cpuSaved, stats.activeCpuRate * 100.0);
+}
@@ -0,0 +1,29 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdbool.h>
+
+// --- POWER CONSTANTS ---
+#define POWER_DEFAULT_REFRESH   60      // refreshes per second when the monitor won't say
+
+// --- STRUCTURES ---
+// Idle time is wall time on static screens, from the frame that started waiting for
+// input to the next frame that had to be drawn. CPU time is the whole process's.
+typedef struct PowerStats {
+    long long framesDrawn;
+    long long framesSkipped;    // refreshes during idle time that were not drawn
+    double idleSeconds;
+    double idleCpu;             // CPU seconds used during idle time
+    double activeCpuRate;       // CPU seconds per second while drawing every refresh
+    double cpuSaved;            // what idle time would have cost at the active rate, less idleCpu
+} PowerStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Main thread only. PowerFrame closes one pass of the main loop: `drawn` if it
+// rendered, `waiting` if it ends by blocking until the next input event.
+void InitPower(int refreshRate);
+void PowerFrame(bool drawn, bool waiting);
+void GetPowerStats(PowerStats *stats);
+void LogPowerStats(void);
+
+#endif // POWER_H
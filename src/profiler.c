@@ -0,0 +1,231 @@
+// src/profiler.c
+#define _POSIX_C_SOURCE 200809L
+#include "profiler.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// --- SAMPLE RING ---
+// Writers claim a slot with one fetch_add on the head and never wait; once the ring
+// wraps the oldest scopes are overwritten. Each slot carries a sequence word, odd
+// while sample n is being written and 2n + 2 once it is complete, so a reader can
+// tell a finished sample from a torn or recycled one without taking a lock.
+typedef struct ProfileSample {
+    const char *name;
+    double start;           // seconds since InitProfiler
+    double duration;
+    int thread;
+} ProfileSample;
+
+typedef struct ProfileSlot {
+    _Atomic unsigned long long seq;
+    ProfileSample sample;
+} ProfileSlot;
+
+static ProfileSlot ring[PROFILE_RING_SIZE];
+static _Atomic unsigned long long ringHead;
+static _Atomic bool enabled;
+static _Atomic int threadCount;
+static double epoch;
+
+static void PushSample(const ProfileSample *sample) {
+    unsigned long long n = atomic_fetch_add_explicit(&ringHead, 1, memory_order_relaxed);
+    ProfileSlot *slot = &ring[n & (PROFILE_RING_SIZE - 1)];
+
+    atomic_store_explicit(&slot->seq, 2 * n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->sample = *sample;
+    atomic_store_explicit(&slot->seq, 2 * n + 2, memory_order_release);
+}
+
+// Copies sample n out of the ring; false if it is still being written or was recycled
+static bool ReadSample(unsigned long long n, ProfileSample *out) {
+    ProfileSlot *slot = &ring[n & (PROFILE_RING_SIZE - 1)];
+    unsigned long long expect = 2 * n + 2;
+
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != expect) return false;
+    *out = slot->sample;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->seq, memory_order_relaxed) == expect;
+}
+
+// Oldest sample index that can still be in the ring
+static unsigned long long RingFirst(unsigned long long head) {
+    return (head > PROFILE_RING_SIZE) ? head - PROFILE_RING_SIZE : 0;
+}
+
+// --- SCOPES ---
+typedef struct OpenScope {
+    const char *name;
+    double start;
+} OpenScope;
+
+static _Thread_local OpenScope scopes[PROFILE_MAX_DEPTH];
+static _Thread_local int depth;
+static _Thread_local int threadId = -1;
+
+void InitProfiler(void) {
+    epoch = NowSeconds();
+    threadId = atomic_fetch_add(&threadCount, 1);   // the caller's thread shows as tid 0
+    atomic_store_explicit(&enabled, true, memory_order_release);
+}
+
+void ProfileBegin(const char *zone) {
+    if (!atomic_load_explicit(&enabled, memory_order_acquire)) return;
+
+    // Scopes nested deeper than the stack are counted but not recorded
+    if (depth < PROFILE_MAX_DEPTH) {
+        scopes[depth].name = zone;
+        scopes[depth].start = NowSeconds();
+    }
+    depth++;
+}
+
+void ProfileEnd(void) {
+    if (!atomic_load_explicit(&enabled, memory_order_acquire)) return;
+    if (depth == 0) return;     // the scope was opened before InitProfiler
+
+    depth--;
+    if (depth >= PROFILE_MAX_DEPTH) return;
+
+    if (threadId < 0) threadId = atomic_fetch_add(&threadCount, 1);
+
+    const OpenScope *scope = &scopes[depth];
+    ProfileSample sample = {
+        scope->name, scope->start - epoch, NowSeconds() - scope->start, threadId
+    };
+    PushSample(&sample);
+}
+
+// --- FRAMES ---
+// Only touched by the thread that calls ProfileFrame
+static float frameMs[PROFILE_FRAMES];
+static int frameDraws[PROFILE_FRAMES];
+static double frameStart[PROFILE_FRAMES];     // seconds since InitProfiler
+static int frameCount;
+static double lastFrame;
+
+void ProfileFrame(int drawCalls) {
+    if (!atomic_load_explicit(&enabled, memory_order_acquire)) return;
+
+    double now = NowSeconds() - epoch;
+    int slot = frameCount % PROFILE_FRAMES;
+    frameStart[slot] = lastFrame;
+    frameMs[slot] = (float)((now - lastFrame) * 1000.0);
+    frameDraws[slot] = drawCalls;
+
+    lastFrame = now;
+    frameCount++;
+}
+
+// --- STATISTICS ---
+static int CompareFloat(const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static int CompareZoneTime(const void *a, const void *b) {
+    double x = ((const ProfileZone *)a)->msPerFrame;
+    double y = ((const ProfileZone *)b)->msPerFrame;
+    return (x < y) - (x > y);
+}
+
+// Nearest-rank percentile of an ascending array
+static double Percentile(const float *sorted, int count, double p) {
+    int rank = (int)(p * count);
+    if (rank >= count) rank = count - 1;
+    return sorted[rank];
+}
+
+// Folds one sample into the per-name totals (msPerFrame/callsPerFrame hold sums until the end)
+static void AddZone(ProfileStats *stats, const ProfileSample *sample) {
+    for (int i = 0; i < stats->zoneCount; i++) {
+        ProfileZone *zone = &stats->zones[i];
+        if (zone->name == sample->name || strcmp(zone->name, sample->name) == 0) {
+            zone->msPerFrame += sample->duration * 1000.0;
+            zone->callsPerFrame += 1.0;
+            return;
+        }
+    }
+    if (stats->zoneCount == PROFILE_MAX_ZONES) return;
+
+    stats->zones[stats->zoneCount++] = (ProfileZone){ sample->name, sample->duration * 1000.0, 1.0 };
+}
+
+void GetProfileStats(ProfileStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    int frames = (frameCount < PROFILE_FRAMES) ? frameCount : PROFILE_FRAMES;
+    stats->frames = frames;
+    if (frames == 0) return;
+
+    float sorted[PROFILE_FRAMES];
+    long long draws = 0;
+    for (int i = 0; i < frames; i++) {
+        sorted[i] = frameMs[i];
+        draws += frameDraws[i];
+    }
+    qsort(sorted, frames, sizeof(float), CompareFloat);
+
+    stats->frameP50 = Percentile(sorted, frames, 0.50);
+    stats->frameP95 = Percentile(sorted, frames, 0.95);
+    stats->frameP99 = Percentile(sorted, frames, 0.99);
+    stats->frameMax = sorted[frames - 1];
+    stats->drawCalls = frameDraws[(frameCount - 1) % PROFILE_FRAMES];
+    stats->drawCallsMean = (double)draws / frames;
+
+    // Scopes that ran entirely inside the window. Samples complete roughly in end-time
+    // order, so walking back from the head can stop at the first one that ended before it.
+    double windowStart = frameStart[(frameCount - frames) % PROFILE_FRAMES];
+    unsigned long long head = atomic_load_explicit(&ringHead, memory_order_acquire);
+
+    for (unsigned long long n = head; n-- > RingFirst(head);) {
+        ProfileSample sample;
+        if (!ReadSample(n, &sample)) {
+            stats->dropped++;
+            continue;
+        }
+        if (sample.start + sample.duration < windowStart) break;
+        if (sample.start < windowStart || sample.start + sample.duration > lastFrame) continue;
+        AddZone(stats, &sample);
+    }
+
+    for (int i = 0; i < stats->zoneCount; i++) {
+        stats->zones[i].msPerFrame /= frames;
+        stats->zones[i].callsPerFrame /= frames;
+    }
+    qsort(stats->zones, stats->zoneCount, sizeof(ProfileZone), CompareZoneTime);
+}
+
+// --- CHROME TRACE ---
+// Complete ("X") events with microsecond timestamps, oldest first
+bool SaveProfileTrace(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}");
+
+    unsigned long long head = atomic_load_explicit(&ringHead, memory_order_acquire);
+    for (unsigned long long n = RingFirst(head); n < head; n++) {
+        ProfileSample sample;
+        if (!ReadSample(n, &sample)) continue;
+
+        fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                sample.name, sample.thread, sample.start * 1e6, sample.duration * 1e6);
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,45 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+
+// --- PROFILER CONSTANTS ---
+#define PROFILE_RING_SIZE   32768   // recorded scopes kept for the trace (power of two)
+#define PROFILE_MAX_DEPTH   32      // nested scopes per thread
+#define PROFILE_FRAMES      240     // frames the overlay statistics cover
+#define PROFILE_MAX_ZONES   16      // distinct scope names shown in the overlay
+
+// --- STRUCTURES ---
+// Per-scope averages over the overlay window
+typedef struct ProfileZone {
+    const char *name;
+    double msPerFrame;      // total time spent in the scope per frame
+    double callsPerFrame;
+} ProfileZone;
+
+typedef struct ProfileStats {
+    int frames;             // frames in the window, up to PROFILE_FRAMES
+    double frameP50, frameP95, frameP99, frameMax;     // frame times in ms
+    int drawCalls;          // last frame
+    double drawCallsMean;
+    int dropped;            // window samples overwritten or torn while reading
+    ProfileZone zones[PROFILE_MAX_ZONES];
+    int zoneCount;
+} ProfileStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Scopes are recorded only after InitProfiler; before that Begin/End cost one branch.
+// Begin/End may be called from any thread. Zone names must be string literals (or
+// otherwise outlive the profiler): only the pointer is stored.
+void InitProfiler(void);
+void ProfileBegin(const char *zone);
+void ProfileEnd(void);
+
+// Closes a frame on the main thread: records its time and draw calls for the overlay
+void ProfileFrame(int drawCalls);
+void GetProfileStats(ProfileStats *stats);
+
+// Writes every scope still in the ring as Chrome trace JSON (chrome://tracing, Perfetto)
+bool SaveProfileTrace(const char *path);
+
+#endif // PROFILER_H
@@ -0,0 +1,338 @@
+// src/raster.c
+#define _POSIX_C_SOURCE 200809L
+#include "raster.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define RASTER_SSE2 1
+#endif
+
+#define RASTER_WHITE 0xFFFFFFFFu
+
+static unsigned int PackColor(Color color) {
+    return (unsigned int)color.r | ((unsigned int)color.g << 8) |
+           ((unsigned int)color.b << 16) | ((unsigned int)color.a << 24);
+}
+
+// --- BLENDING ---
+// Straight alpha over an opaque canvas, as the GPU blends with BLEND_ALPHA:
+// out = src*a + dst*(1 - a), each channel rounded back to 8 bits. The source is
+// tinted first (src*tint), as the default shader does.
+static unsigned int Div255(unsigned int x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static unsigned int BlendPixel(unsigned int dst, unsigned int src, unsigned int tint) {
+    if (tint != RASTER_WHITE) {
+        unsigned int tinted = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            tinted |= Div255(((src >> shift) & 0xFF) * ((tint >> shift) & 0xFF)) << shift;
+        }
+        src = tinted;
+    }
+
+    unsigned int a = src >> 24;
+    unsigned int out = 0xFF000000u;
+    for (int shift = 0; shift < 24; shift += 8) {
+        unsigned int s = (src >> shift) & 0xFF;
+        unsigned int d = (dst >> shift) & 0xFF;
+        out |= Div255(s * a + d * (255 - a)) << shift;
+    }
+    return out;
+}
+
+#if RASTER_SSE2
+// Same rounding as Div255, on eight 16-bit lanes; exact for x <= 255*255
+static __m128i Div255x8(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Two pixels widened to 16 bits a channel: tint, then blend onto dst
+static __m128i BlendPair(__m128i s, __m128i d, __m128i tint, bool tinted) {
+    if (tinted) s = Div255x8(_mm_mullo_epi16(s, tint));
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+    __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    return Div255x8(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, inv)));
+}
+#endif
+
+// Blends count source pixels over dst; transparent source pixels leave dst as it was
+static void BlendSpan(unsigned int *dst, const unsigned int *src, int count, unsigned int tint) {
+    int i = 0;
+#if RASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tint16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)tint), zero);
+    const __m128i opaque = _mm_set1_epi32((int)0xFF000000u);
+    bool tinted = tint != RASTER_WHITE;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i lo = BlendPair(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), tint16, tinted);
+        __m128i hi = BlendPair(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), tint16, tinted);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+    }
+#endif
+    for (; i < count; i++) dst[i] = BlendPixel(dst[i], src[i], tint);
+}
+
+// --- QUAD SETUP ---
+static RasterQuad *PushQuad(RasterCanvas *canvas) {
+    if (canvas->quadCount == canvas->quadCapacity) {
+        int capacity = canvas->quadCapacity ? canvas->quadCapacity * 2 : 256;
+        RasterQuad *grown = realloc(canvas->quads, capacity * sizeof(RasterQuad));
+        if (grown == NULL) return NULL;
+        canvas->quads = grown;
+        canvas->quadCapacity = capacity;
+    }
+    return &canvas->quads[canvas->quadCount++];
+}
+
+static int ClampInt(int value, int min, int max) {
+    return (value < min) ? min : (value > max) ? max : value;
+}
+
+// The quad is dest moved by -origin and turned by `rotation` degrees about (dest.x, dest.y),
+// exactly as DrawTexturePro builds its vertices
+static RasterQuad *SetupQuad(RasterCanvas *canvas, Rectangle dest, Vector2 origin, float rotation) {
+    if (dest.width <= 0.0f || dest.height <= 0.0f) return NULL;
+
+    float c = 1.0f, s = 0.0f;
+    if (rotation != 0.0f) {
+        c = cosf(rotation * DEG2RAD);
+        s = sinf(rotation * DEG2RAD);
+    }
+
+    // Screen bounds of the four corners
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int corner = 0; corner < 4; corner++) {
+        float lx = ((corner & 1) ? dest.width : 0.0f) - origin.x;
+        float ly = ((corner & 2) ? dest.height : 0.0f) - origin.y;
+        float x = dest.x + lx * c - ly * s;
+        float y = dest.y + lx * s + ly * c;
+        minX = fminf(minX, x); maxX = fmaxf(maxX, x);
+        minY = fminf(minY, y); maxY = fmaxf(maxY, y);
+    }
+
+    // Pixels whose centres fall inside, clipped to the canvas
+    int x0 = ClampInt((int)ceilf(minX - 0.5f), 0, canvas->width);
+    int x1 = ClampInt((int)ceilf(maxX - 0.5f), 0, canvas->width);
+    int y0 = ClampInt((int)ceilf(minY - 0.5f), 0, canvas->height);
+    int y1 = ClampInt((int)ceilf(maxY - 0.5f), 0, canvas->height);
+    if (x0 >= x1 || y0 >= y1) return NULL;
+
+    RasterQuad *quad = PushQuad(canvas);
+    if (quad == NULL) return NULL;
+    *quad = (RasterQuad){ .minX = x0, .minY = y0, .maxX = x1, .maxY = y1 };
+
+    // Inverse of the placement, evaluated at pixel centres
+    quad->sx = c / dest.width;
+    quad->sy = s / dest.width;
+    quad->s0 = (origin.x - c * dest.x - s * dest.y) / dest.width + 0.5f * (quad->sx + quad->sy);
+    quad->tx = -s / dest.height;
+    quad->ty = c / dest.height;
+    quad->t0 = (origin.y + s * dest.x - c * dest.y) / dest.height + 0.5f * (quad->tx + quad->ty);
+    return quad;
+}
+
+void RasterTexturePro(RasterCanvas *canvas, Rectangle source, Rectangle dest, Vector2 origin,
+                      float rotation, Color tint) {
+    if (canvas->texture == NULL || tint.a == 0) return;
+
+    RasterQuad *quad = SetupQuad(canvas, dest, origin, rotation);
+    if (quad == NULL) return;
+
+    // A negative size samples the same texels back to front
+    quad->texX = (source.width < 0.0f) ? source.x - source.width : source.x;
+    quad->texW = source.width;
+    quad->texY = (source.height < 0.0f) ? source.y - source.height : source.y;
+    quad->texH = source.height;
+
+    quad->clipX0 = ClampInt((int)floorf(source.x), 0, canvas->textureWidth - 1);
+    quad->clipX1 = ClampInt((int)ceilf(source.x + fabsf(source.width)) - 1, 0, canvas->textureWidth - 1);
+    quad->clipY0 = ClampInt((int)floorf(source.y), 0, canvas->textureHeight - 1);
+    quad->clipY1 = ClampInt((int)ceilf(source.y + fabsf(source.height)) - 1, 0, canvas->textureHeight - 1);
+
+    quad->color = PackColor(tint);
+    quad->solid = false;
+}
+
+void RasterRectangle(RasterCanvas *canvas, Rectangle rec, Color color) {
+    if (color.a == 0) return;
+
+    RasterQuad *quad = SetupQuad(canvas, rec, (Vector2){ 0, 0 }, 0.0f);
+    if (quad == NULL) return;
+    quad->color = PackColor(color);
+    quad->solid = true;
+}
+
+// --- TILES ---
+static void RasterQuadRows(const RasterCanvas *canvas, const RasterQuad *quad, int x0, int x1, int y0, int y1) {
+    unsigned int span[RASTER_TILE];
+    int count = x1 - x0;
+    bool rotated = quad->sy != 0.0f || quad->tx != 0.0f;
+
+    if (quad->solid) {
+        for (int i = 0; i < count; i++) span[i] = quad->color;
+        for (int y = y0; y < y1; y++) BlendSpan(canvas->pixels + (size_t)y * canvas->width + x0, span, count, RASTER_WHITE);
+        return;
+    }
+
+    for (int y = y0; y < y1; y++) {
+        float s = quad->s0 + x0 * quad->sx + y * quad->sy;
+        float t = quad->t0 + x0 * quad->tx + y * quad->ty;
+
+        if (!rotated) {
+            // The bounds already are the coverage; one texel row for the whole span
+            int ty = ClampInt((int)(quad->texY + t * quad->texH), quad->clipY0, quad->clipY1);
+            const unsigned int *row = canvas->texture + (size_t)ty * canvas->textureWidth;
+            for (int i = 0; i < count; i++) {
+                float u = quad->texX + (s + i * quad->sx) * quad->texW;
+                span[i] = row[ClampInt((int)u, quad->clipX0, quad->clipX1)];
+            }
+        } else {
+            for (int i = 0; i < count; i++) {
+                float si = s + i * quad->sx;
+                float ti = t + i * quad->tx;
+                if (si < 0.0f || si >= 1.0f || ti < 0.0f || ti >= 1.0f) {
+                    span[i] = 0;
+                    continue;
+                }
+                int tx = ClampInt((int)(quad->texX + si * quad->texW), quad->clipX0, quad->clipX1);
+                int ty = ClampInt((int)(quad->texY + ti * quad->texH), quad->clipY0, quad->clipY1);
+                span[i] = canvas->texture[(size_t)ty * canvas->textureWidth + tx];
+            }
+        }
+        BlendSpan(canvas->pixels + (size_t)y * canvas->width + x0, span, count, quad->color);
+    }
+}
+
+static void RasterTile(RasterCanvas *canvas, int tile) {
+    int x0 = (tile % canvas->tilesX) * RASTER_TILE;
+    int y0 = (tile / canvas->tilesX) * RASTER_TILE;
+    int x1 = (x0 + RASTER_TILE < canvas->width) ? x0 + RASTER_TILE : canvas->width;
+    int y1 = (y0 + RASTER_TILE < canvas->height) ? y0 + RASTER_TILE : canvas->height;
+
+    for (int y = y0; y < y1; y++) {
+        unsigned int *row = canvas->pixels + (size_t)y * canvas->width;
+        for (int x = x0; x < x1; x++) row[x] = canvas->clear;
+    }
+
+    for (int i = 0; i < canvas->quadCount; i++) {
+        const RasterQuad *quad = &canvas->quads[i];
+        int qx0 = (quad->minX > x0) ? quad->minX : x0;
+        int qx1 = (quad->maxX < x1) ? quad->maxX : x1;
+        int qy0 = (quad->minY > y0) ? quad->minY : y0;
+        int qy1 = (quad->maxY < y1) ? quad->maxY : y1;
+        if (qx0 < qx1 && qy0 < qy1) RasterQuadRows(canvas, quad, qx0, qx1, qy0, qy1);
+    }
+}
+
+static void RunTiles(RasterCanvas *canvas) {
+    int tiles = canvas->tilesX * canvas->tilesY;
+    int tile;
+    while ((tile = atomic_fetch_add_explicit(&canvas->nextTile, 1, memory_order_relaxed)) < tiles) {
+        RasterTile(canvas, tile);
+    }
+}
+
+// --- WORKERS ---
+static void *RasterWorker(void *arg) {
+    RasterCanvas *canvas = arg;
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&canvas->lock);
+    for (;;) {
+        while (canvas->generation == seen && !canvas->closing) pthread_cond_wait(&canvas->start, &canvas->lock);
+        if (canvas->closing) break;
+        seen = canvas->generation;
+        pthread_mutex_unlock(&canvas->lock);
+
+        RunTiles(canvas);
+
+        pthread_mutex_lock(&canvas->lock);
+        if (--canvas->busy == 0) pthread_cond_signal(&canvas->done);
+    }
+    pthread_mutex_unlock(&canvas->lock);
+    return NULL;
+}
+
+bool InitRasterCanvas(RasterCanvas *canvas, int width, int height, int threads) {
+    memset(canvas, 0, sizeof(*canvas));
+    canvas->width = width;
+    canvas->height = height;
+    canvas->tilesX = (width + RASTER_TILE - 1) / RASTER_TILE;
+    canvas->tilesY = (height + RASTER_TILE - 1) / RASTER_TILE;
+    canvas->pixels = calloc((size_t)width * height, sizeof(unsigned int));
+    if (canvas->pixels == NULL) return false;
+
+    if (threads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cores > 0) ? (int)cores : 1;
+    }
+    if (threads > RASTER_MAX_THREADS) threads = RASTER_MAX_THREADS;
+
+    pthread_mutex_init(&canvas->lock, NULL);
+    pthread_cond_init(&canvas->start, NULL);
+    pthread_cond_init(&canvas->done, NULL);
+    canvas->threads = 1;
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&canvas->workers[i], NULL, RasterWorker, canvas) != 0) break;
+        canvas->threads++;
+    }
+    return true;
+}
+
+void FreeRasterCanvas(RasterCanvas *canvas) {
+    if (canvas->pixels == NULL) return;
+
+    pthread_mutex_lock(&canvas->lock);
+    canvas->closing = true;
+    pthread_cond_broadcast(&canvas->start);
+    pthread_mutex_unlock(&canvas->lock);
+    for (int i = 1; i < canvas->threads; i++) pthread_join(canvas->workers[i], NULL);
+
+    pthread_mutex_destroy(&canvas->lock);
+    pthread_cond_destroy(&canvas->start);
+    pthread_cond_destroy(&canvas->done);
+    free(canvas->pixels);
+    free(canvas->quads);
+    memset(canvas, 0, sizeof(*canvas));
+}
+
+// --- FRAME ---
+void RasterBegin(RasterCanvas *canvas, const Image *texture, Color clear) {
+    bool usable = texture != NULL && texture->data != NULL &&
+                  texture->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    canvas->texture = usable ? texture->data : NULL;
+    canvas->textureWidth = usable ? texture->width : 0;
+    canvas->textureHeight = usable ? texture->height : 0;
+    canvas->clear = PackColor(clear) | 0xFF000000u;
+    canvas->quadCount = 0;
+}
+
+void RasterEnd(RasterCanvas *canvas) {
+    atomic_store_explicit(&canvas->nextTile, 0, memory_order_relaxed);
+
+    if (canvas->threads > 1) {
+        pthread_mutex_lock(&canvas->lock);
+        canvas->busy = canvas->threads - 1;
+        canvas->generation++;
+        pthread_cond_broadcast(&canvas->start);
+        pthread_mutex_unlock(&canvas->lock);
+    }
+
+    RunTiles(canvas);
+
+    if (canvas->threads > 1) {
+        pthread_mutex_lock(&canvas->lock);
+        while (canvas->busy > 0) pthread_cond_wait(&canvas->done, &canvas->lock);
+        pthread_mutex_unlock(&canvas->lock);
+    }
+}
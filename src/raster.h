@@ -0,0 +1,72 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "raylib.h"
+
+// --- RASTER CONSTANTS ---
+#define RASTER_TILE         64      // tiles are this many pixels square
+#define RASTER_MAX_THREADS  16
+
+// --- STRUCTURES ---
+// One textured or solid quad, set up for scanning: for the pixel centre (x, y) the
+// quad-local coordinates are s = s0 + x*sx + y*sy and t = t0 + x*tx + y*ty, and the
+// pixel is covered while both are in [0, 1).
+typedef struct RasterQuad {
+    int minX, minY, maxX, maxY;     // pixel bounds, max exclusive, inside the canvas
+    float s0, sx, sy;
+    float t0, tx, ty;
+    float texX, texW;               // texel column at s: texX + s*texW (texW < 0 when flipped)
+    float texY, texH;
+    int clipX0, clipX1, clipY0, clipY1;     // texels the source rectangle covers
+    unsigned int color;             // RGBA8 tint, or the colour of a solid quad
+    bool solid;
+} RasterQuad;
+
+// A CPU framebuffer and the quads queued for it. Quads are recorded in draw order
+// and rasterised tile by tile at RasterEnd, each tile by whichever thread claims it,
+// so every pixel still sees the quads in order.
+typedef struct RasterCanvas {
+    int width, height;
+    unsigned int *pixels;           // RGBA8, top row first, alpha always 255
+    unsigned int clear;
+
+    const unsigned int *texture;    // RGBA8, as set by RasterBegin
+    int textureWidth, textureHeight;
+
+    RasterQuad *quads;
+    int quadCount;
+    int quadCapacity;
+
+    // Tile workers; the calling thread works too, so threads - 1 of them are started
+    int threads;
+    int tilesX, tilesY;
+    _Atomic int nextTile;
+    pthread_t workers[RASTER_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned int generation;
+    int busy;
+    bool closing;
+} RasterCanvas;
+
+// --- FUNCTION PROTOTYPES ---
+// threads 0 = one per core. Fewer threads than asked for may start; the canvas works
+// with however many did.
+bool InitRasterCanvas(RasterCanvas *canvas, int width, int height, int threads);
+void FreeRasterCanvas(RasterCanvas *canvas);
+
+// Starts a frame that samples `texture` (RGBA8, which must outlive RasterEnd)
+void RasterBegin(RasterCanvas *canvas, const Image *texture, Color clear);
+// Same placement, flipping (negative source sizes), rotation and tint as DrawTexturePro,
+// with point sampling and alpha blending
+void RasterTexturePro(RasterCanvas *canvas, Rectangle source, Rectangle dest, Vector2 origin,
+                      float rotation, Color tint);
+void RasterRectangle(RasterCanvas *canvas, Rectangle rec, Color color);
+// Clears and rasterises everything queued since RasterBegin
+void RasterEnd(RasterCanvas *canvas);
+
+#endif // RASTER_H
@@ -0,0 +1,662 @@
+// src/render.c
+#include "render.h"
+#include "player.h"
+#include "atlas.h"
+#include "assets.h"
+#include "text.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// --- HELPER FUNCTION PROTOTYPES ---
+static void DrawWaitingScreen(const Assets *assets);
+static void DrawGameOverScreen(const Assets *assets);
+static void DrawPauseScreen(const Assets *assets);
+static void DrawSettingsScreen(const Game *game, const Assets *assets);
+static void DrawLives(const Game *game, const Assets *assets);
+static void DrawRespawnCountdown(const Game *game, const Assets *assets);
+static void DrawScene(const Game *game, const Game *prev, float alpha, const Assets *assets);
+static void ResetUiText(void);
+
+// --- ASSETS ---
+#define HEART_PIXEL_SIZE 2  // screen pixels per heart texel
+
+// The font texture is the atlas, so only the glyph data is released with it
+static void UnloadAtlas(Assets *assets) {
+    SetShapesTexture((Texture2D){ 0 }, (Rectangle){ 0 });
+    UnloadTexture(assets->atlas);
+    UnloadImage(assets->atlasPixels);
+    assets->atlasPixels = (Image){ 0 };
+
+    if (assets->font.glyphs != NULL) {
+        UnloadFontData(assets->font.glyphs, assets->font.glyphCount);
+        MemFree(assets->font.recs);
+    }
+    assets->font = (Font){ 0 };
+}
+
+// Uploads the decoded atlas and takes over the font's glyph tables
+static void UploadAtlas(Assets *assets, AssetData *data) {
+    const Rectangle *regions = data->regions;
+    assets->atlas = LoadTextureFromImage(data->atlas);
+    // A copy: the decoded image may point into the mapped archive
+    assets->atlasPixels = ImageCopy(data->atlas);
+
+    assets->recBg   = regions[ATLAS_BG];
+    assets->recPipe = regions[ATLAS_PIPE];
+    assets->recBird = regions[ATLAS_BIRD];
+    assets->recHeartFull  = regions[ATLAS_HEART_FULL];
+    assets->recHeartEmpty = regions[ATLAS_HEART_EMPTY];
+    // Sample the middle of the white block so edge filtering never picks up padding
+    assets->recWhite = AtlasRect(regions[ATLAS_WHITE], 1, 1, 2, 2);
+
+    assets->font = data->font;
+    assets->font.texture = assets->atlas;
+    data->font.glyphs = NULL;
+    data->font.recs = NULL;
+
+    // The font changed underneath the retained layouts
+    ResetUiText();
+
+    // Rectangles draw from the atlas too, so they don't break the batch
+    SetShapesTexture(assets->atlas, assets->recWhite);
+}
+
+// --- DRAW CALLS ---
+// The frame is submitted through our own rlgl batch rather than raylib's internal one,
+// so the number of draw calls queued since the last flush can be read back for the
+// profiler. It has the same buffer size as the default batch.
+static rlRenderBatch frameBatch;
+
+int GetFrameDrawCalls(void) {
+    return frameBatch.drawCounter;
+}
+
+// Only the placeholder atlas is built here, so the first frame doesn't wait on any
+// file; the archive or loose files are read by the loader's worker thread.
+void LoadAssets(Assets *assets, const Settings *settings) {
+    *assets = (Assets){ 0 };
+
+    AssetData placeholder;
+    LoadBuiltinGlyphs(&assets->loader.builtinFont);
+    BuildPlaceholderAtlas(&placeholder, &assets->loader.builtinFont);
+    UploadAtlas(assets, &placeholder);
+    UnloadAssetData(&placeholder);
+
+    frameBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    rlSetRenderBatchActive(&frameBatch);
+
+    InitAudioDevice();
+    InitMixer();
+    SetMixerVolume(settings->sfxVolume);
+    StartAssetLoader(&assets->loader);
+    assets->loading = true;
+
+    UpdateAssets(assets);
+}
+
+void UpdateAssets(Assets *assets) {
+    if (!assets->loading) return;
+
+    AssetLoader *loader = &assets->loader;
+    AssetLoad load;
+    while (PollAssetLoader(loader, &load)) {
+        switch (load.kind) {
+            case ASSET_LOAD_ATLAS:
+                ProfileBegin("UploadAtlas");
+                UnloadAtlas(assets);
+                UploadAtlas(assets, &loader->data);
+                ProfileEnd();
+                TraceLog(LOG_INFO, "ASSETS: Atlas loaded from %s", loader->fromArchive ? ASSET_ARCHIVE : "loose files");
+                break;
+            case ASSET_LOAD_SOUND:
+                if (loader->data.sounds[load.index].data == NULL) break;
+                SetMixerSound(load.index, loader->data.sounds[load.index]);
+                break;
+            case ASSET_LOAD_FAILED:
+                TraceLog(LOG_WARNING, "ASSETS: Failed to build the atlas, keeping placeholders");
+                break;
+        }
+    }
+
+    if (AssetLoaderDone(loader)) {
+        FinishAssetLoader(loader);
+        assets->loading = false;
+    }
+}
+
+void UnloadAssets(Assets *assets) {
+    // Waits for a load still in progress
+    if (assets->loading) FinishAssetLoader(&assets->loader);
+
+    SetRenderBackend(assets, RENDER_GPU);
+    rlSetRenderBatchActive(NULL);
+    rlUnloadRenderBatch(frameBatch);
+    UnloadAtlas(assets);
+
+    CloseMixer();
+    CloseAudioDevice();
+}
+
+// --- BACKEND ---
+// Everything DrawGame draws goes through these three, so the software backend gets the
+// same quads in the same order as the GPU batch
+static RasterCanvas *rasterTarget;     // set while RasterGame is drawing
+
+static void DrawAtlasQuad(const Assets *assets, Rectangle src, Rectangle dst, Vector2 origin, float rotation, Color tint) {
+    if (rasterTarget != NULL) RasterTexturePro(rasterTarget, src, dst, origin, rotation, tint);
+    else DrawTexturePro(assets->atlas, src, dst, origin, rotation, tint);
+}
+
+static void FillRect(int x, int y, int width, int height, Color color) {
+    if (rasterTarget != NULL) RasterRectangle(rasterTarget, (Rectangle){ (float)x, (float)y, (float)width, (float)height }, color);
+    else DrawRectangle(x, y, width, height, color);
+}
+
+// The font's glyphs are in the atlas, so its quads sample the same texture
+static void DrawUiLayout(const TextLayout *layout, Vector2 position, Color tint) {
+    if (rasterTarget == NULL) {
+        DrawTextLayout(layout, position, tint);
+        return;
+    }
+    if (layout->font == NULL) return;
+    for (int i = 0; i < layout->quadCount; i++) {
+        Rectangle dst = layout->quads[i].dst;
+        dst.x += position.x;
+        dst.y += position.y;
+        RasterTexturePro(rasterTarget, layout->quads[i].src, dst, (Vector2){0, 0}, 0.0f, tint);
+    }
+}
+
+// --- BIRD ---
+#define GHOST_ALPHA 0.45f   // opacity of the rival's bird in versus
+
+// Draw using ENTIRE bird.png as a single frame (no sprite sheet)
+static void DrawBirdTinted(const Bird *bird, const Assets *assets, Vector2 offset, Color tint) {
+    Rectangle destRec = {
+        bird->position.x + offset.x,
+        bird->position.y + offset.y,
+        bird->size.x,
+        bird->size.y
+    };
+
+    Vector2 origin = { bird->size.x * 0.5f, bird->size.y * 0.5f };
+    float angle = bird->rotation;
+
+    DrawAtlasQuad(
+        assets,
+        assets->recBird,
+        destRec,
+        origin,
+        angle,
+        tint
+    );
+}
+
+void DrawBirdSprite(const Bird *bird, const Assets *assets, Vector2 offset) {
+    DrawBirdTinted(bird, assets, offset, WHITE);
+}
+
+// --- DRAWING HELPERS ---
+static void DrawLives(const Game *game, const Assets *assets) {
+    int spacing = 40;
+    int startX = SCREEN_WIDTH - (MAX_LIVES * spacing) - 15;
+    int startY = 15;
+
+    // One quad per heart, scaled up from the baked 1:1 pattern
+    for (int i = 0; i < MAX_LIVES; i++) {
+        Rectangle src = (i < game->lives) ? assets->recHeartFull : assets->recHeartEmpty;
+        Rectangle dst = {
+            (float)(startX + i * spacing), (float)startY,
+            src.width * HEART_PIXEL_SIZE, src.height * HEART_PIXEL_SIZE
+        };
+        DrawAtlasQuad(assets, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
+    }
+}
+
+// --- TEXT ---
+#define UI_TEXT_SPACING 2.0f
+
+// Every string on screen has its own retained layout slot; a slot is only laid out
+// again when the string in it changes (score, volume, countdown...).
+enum {
+    TEXT_SCORE, TEXT_BEST, TEXT_RIVAL,
+    TEXT_COUNTDOWN, TEXT_LIVES_LEFT,
+    TEXT_WAIT_TITLE, TEXT_WAIT_HINT, TEXT_WAIT_SETTINGS,
+    TEXT_OVER_TITLE, TEXT_OVER_HINT, TEXT_OVER_MENU,
+    TEXT_PAUSE_TITLE, TEXT_PAUSE_RESUME, TEXT_PAUSE_SETTINGS,
+    TEXT_SETTINGS_TITLE, TEXT_SETTINGS_VOLUME, TEXT_SETTINGS_SHAKE, TEXT_SETTINGS_COURSE,
+    TEXT_SETTINGS_CONTROLS1, TEXT_SETTINGS_CONTROLS2, TEXT_SETTINGS_CONTROLS3, TEXT_SETTINGS_BACK,
+    TEXT_SLOTS
+};
+
+static TextLayout uiText[TEXT_SLOTS];
+
+static void ResetUiText(void) {
+    memset(uiText, 0, sizeof(uiText));
+}
+
+static const TextLayout *UiText(int slot, const Assets *assets, const char *text, float size) {
+    UpdateTextLayout(&uiText[slot], &assets->font, text, size, UI_TEXT_SPACING);
+    return &uiText[slot];
+}
+
+static float CenteredX(const TextLayout *layout) {
+    return (SCREEN_WIDTH - layout->extent.x) / 2.0f;
+}
+
+// Draws a layout with a drop shadow behind it
+static void DrawShadowedText(const TextLayout *layout, Vector2 pos, Vector2 shadowOffset, Color color, Color shadow) {
+    DrawUiLayout(layout, (Vector2){ pos.x + shadowOffset.x, pos.y + shadowOffset.y }, shadow);
+    DrawUiLayout(layout, pos, color);
+}
+
+static void DrawRespawnCountdown(const Game *game, const Assets *assets) {
+    FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
+    
+    Color yellow = (Color){ 255, 230, 0, 255 };
+    Color shadow = (Color){ 0, 0, 0, 160 };
+    Vector2 shadowOffset = { 3, 3 };
+    
+    int countdown = (int)ceilf(game->respawnTimer);
+    const char *text;
+    
+    if (countdown == 3) text = "3";
+    else if (countdown == 2) text = "2";
+    else if (countdown == 1) text = "1";
+    else text = "GO!";
+    
+    const TextLayout *count = UiText(TEXT_COUNTDOWN, assets, text, 72.0f);
+    Vector2 countPos = { CenteredX(count), (SCREEN_HEIGHT - count->extent.y) / 2.0f };
+    DrawShadowedText(count, countPos, shadowOffset, yellow, shadow);
+    
+    // Show remaining lives message
+    const TextLayout *lifeMsg = UiText(TEXT_LIVES_LEFT, assets, TextFormat("LIVES REMAINING: %d", game->lives), 24.0f);
+    DrawUiLayout(lifeMsg, (Vector2){ CenteredX(lifeMsg), SCREEN_HEIGHT / 2.0f + 80 }, WHITE);
+}
+
+static void DrawWaitingScreen(const Assets *assets) {
+    FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.7f));
+
+    Color uiColor = (Color){ 255, 230, 0, 255 };
+    Color shadow  = (Color){ 0, 0, 0, 160 };
+    Vector2 shadowOffset = { 2, 2 };
+
+    const TextLayout *title = UiText(TEXT_WAIT_TITLE, assets, "FLAPPY BIRD", 48.0f);
+    float titleY = SCREEN_HEIGHT / 2.0f - 100.0f;
+    DrawShadowedText(title, (Vector2){ CenteredX(title), titleY }, shadowOffset, uiColor, shadow);
+
+    const TextLayout *hint = UiText(TEXT_WAIT_HINT, assets, "Press SPACE or Click to Start", 24.0f);
+    float hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
+    DrawShadowedText(hint, (Vector2){ CenteredX(hint), hintY }, (Vector2){ 1, 1 }, WHITE, shadow);
+
+    const TextLayout *settings = UiText(TEXT_WAIT_SETTINGS, assets, "Press ESC for Settings", 20.0f);
+    DrawShadowedText(settings, (Vector2){ CenteredX(settings), hintY + 40 }, (Vector2){ 1, 1 },
+                     (Color){200, 200, 200, 255}, (Color){40, 40, 40, 255});
+}
+
+static void DrawGameOverScreen(const Assets *assets) {
+    FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.5f));
+
+    Color uiColor = (Color){ 255, 230, 0, 255 };
+    Color shadow  = (Color){ 0, 0, 0, 160 };
+    Vector2 shadowOffset = { 2, 2 };
+
+    const TextLayout *msg = UiText(TEXT_OVER_TITLE, assets, "GAME OVER", 48.0f);
+    float msgY = SCREEN_HEIGHT / 2.0f - 60.0f;
+    DrawShadowedText(msg, (Vector2){ CenteredX(msg), msgY }, shadowOffset, uiColor, shadow);
+
+    const TextLayout *hint = UiText(TEXT_OVER_HINT, assets, "Press SPACE or Click to Restart", 24.0f);
+    float hintY = SCREEN_HEIGHT / 2.0f + 10.0f;
+    DrawShadowedText(hint, (Vector2){ CenteredX(hint), hintY }, (Vector2){ 1, 1 }, WHITE, shadow);
+
+    const TextLayout *menu = UiText(TEXT_OVER_MENU, assets, "Press ESC for Menu", 20.0f);
+    DrawShadowedText(menu, (Vector2){ CenteredX(menu), hintY + 40 }, (Vector2){ 1, 1 },
+                     (Color){200, 200, 200, 255}, (Color){40, 40, 40, 255});
+}
+
+static void DrawPauseScreen(const Assets *assets) {
+    FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.6f));
+    
+    Color yellow = (Color){ 255, 230, 0, 255 };
+    Color lightGrey = (Color){ 200, 200, 200, 255 };
+    Color darkShadow = (Color){ 40, 40, 40, 255 };
+    
+    const TextLayout *title = UiText(TEXT_PAUSE_TITLE, assets, "PAUSED", 48.0f);
+    DrawUiLayout(title, (Vector2){ CenteredX(title), SCREEN_HEIGHT / 2.0f - 50 }, yellow);
+    
+    const TextLayout *resume = UiText(TEXT_PAUSE_RESUME, assets, "Press ESC or P to Resume", 24.0f);
+    DrawUiLayout(resume, (Vector2){ CenteredX(resume), SCREEN_HEIGHT / 2.0f + 20 }, WHITE);
+    
+    const TextLayout *settings = UiText(TEXT_PAUSE_SETTINGS, assets, "Press S for Settings", 20.0f);
+    DrawShadowedText(settings, (Vector2){ CenteredX(settings), SCREEN_HEIGHT / 2.0f + 60 }, (Vector2){ 1, 1 },
+                     lightGrey, darkShadow);
+}
+
+static void DrawSettingsScreen(const Game *game, const Assets *assets) {
+    FillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.8f));
+    
+    Color yellow = (Color){ 255, 230, 0, 255 };
+    Color lightGrey = (Color){ 200, 200, 200, 255 };
+    Color darkShadow = (Color){ 40, 40, 40, 255 };
+    
+    int yPos = 150;
+    
+    const TextLayout *title = UiText(TEXT_SETTINGS_TITLE, assets, "SETTINGS", 48.0f);
+    DrawUiLayout(title, (Vector2){ CenteredX(title), 100 }, yellow);
+    
+    const TextLayout *volume = UiText(TEXT_SETTINGS_VOLUME, assets,
+                                      TextFormat("SFX Volume: %.0f%%", game->settings.sfxVolume * 100), 24.0f);
+    DrawUiLayout(volume, (Vector2){ 100, yPos }, WHITE);
+    
+    const TextLayout *shake = UiText(TEXT_SETTINGS_SHAKE, assets,
+                                     TextFormat("Screen Shake: %s", game->settings.screenShake ? "ON" : "OFF"), 24.0f);
+    DrawUiLayout(shake, (Vector2){ 100, yPos + 50 }, WHITE);
+    
+    const TextLayout *course = UiText(TEXT_SETTINGS_COURSE, assets,
+                                      TextFormat("Course: %s", CourseName(game->settings.course)), 24.0f);
+    DrawUiLayout(course, (Vector2){ 100, yPos + 90 }, WHITE);
+    
+    const TextLayout *controls1 = UiText(TEXT_SETTINGS_CONTROLS1, assets, "UP/DOWN - Adjust Volume", 18.0f);
+    DrawShadowedText(controls1, (Vector2){ 100, yPos + 160 }, (Vector2){ 1, 1 }, lightGrey, darkShadow);
+    
+    const TextLayout *controls2 = UiText(TEXT_SETTINGS_CONTROLS2, assets, "T - Toggle Screen Shake", 18.0f);
+    DrawShadowedText(controls2, (Vector2){ 100, yPos + 190 }, (Vector2){ 1, 1 }, lightGrey, darkShadow);
+    
+    const TextLayout *controls3 = UiText(TEXT_SETTINGS_CONTROLS3, assets, "C - Change Course (next run)", 18.0f);
+    DrawShadowedText(controls3, (Vector2){ 100, yPos + 220 }, (Vector2){ 1, 1 }, lightGrey, darkShadow);
+    
+    const TextLayout *back = UiText(TEXT_SETTINGS_BACK, assets, "Press ESC or ENTER to Save & Exit", 20.0f);
+    DrawUiLayout(back, (Vector2){ CenteredX(back), SCREEN_HEIGHT - 80 }, YELLOW);
+    
+    // Volume bar
+    FillRect(100, yPos + 25, 300, 10, DARKGRAY);
+    FillRect(100, yPos + 25, (int)(300 * game->settings.sfxVolume), 10, GREEN);
+}
+
+// --- INTERPOLATION ---
+static float Lerp1(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// Blend the bird from the previous tick towards the current one.
+// Anything that jumped between ticks (state change, respawn) snaps.
+static void InterpolateBird(Game *view, const Game *prev, float alpha) {
+    if (prev->state != view->state) return;
+
+    view->bird.position.y = Lerp1(prev->bird.position.y, view->bird.position.y, alpha);
+    view->bird.rotation   = Lerp1(prev->bird.rotation, view->bird.rotation, alpha);
+}
+
+// Pipe i of the current ring, `alpha` of the way through the last tick. The same pipe is
+// found in the previous ring by its spawn serial; new or respawned pipes snap.
+static float InterpolatePipeX(const Game *prev, const Game *game, int i, float alpha) {
+    const PipeRing *ring = &game->pipes;
+    const PipeRing *from = &prev->pipes;
+    float x = ring->x[PipeSlot(ring, i)];
+
+    if (prev->state != game->state) return x;
+
+    int j = (int)(PipeSerial(ring, i) - PipeSerial(from, 0));
+    if (j < 0 || j >= from->count) return x;
+
+    float fromX = from->x[PipeSlot(from, j)];
+    return (fromX < x) ? x : Lerp1(fromX, x, alpha);
+}
+
+bool SetRenderBackend(Assets *assets, RenderBackend backend) {
+    if (backend == assets->backend) return true;
+
+    if (backend == RENDER_SOFTWARE) {
+        RasterCanvas *canvas = malloc(sizeof(RasterCanvas));
+        if (canvas == NULL || !InitRasterCanvas(canvas, SCREEN_WIDTH, SCREEN_HEIGHT, 0)) {
+            free(canvas);
+            TraceLog(LOG_WARNING, "RENDER: Failed to allocate the software framebuffer");
+            return false;
+        }
+        Image frame = { canvas->pixels, SCREEN_WIDTH, SCREEN_HEIGHT, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        assets->rasterTexture = LoadTextureFromImage(frame);
+        assets->raster = canvas;
+        TraceLog(LOG_INFO, "RENDER: Software backend, %d threads", canvas->threads);
+    } else {
+        UnloadTexture(assets->rasterTexture);
+        assets->rasterTexture = (Texture2D){ 0 };
+        FreeRasterCanvas(assets->raster);
+        free(assets->raster);
+        assets->raster = NULL;
+        TraceLog(LOG_INFO, "RENDER: GPU backend");
+    }
+    assets->backend = backend;
+    return true;
+}
+
+// --- DRAW ---
+void RasterGame(RasterCanvas *canvas, const Game *prev, const Game *game, float alpha, const Assets *assets) {
+    ProfileBegin("RasterGame");
+    Game view = *game;
+    InterpolateBird(&view, prev, alpha);
+
+    RasterBegin(canvas, &assets->atlasPixels, RAYWHITE);
+    rasterTarget = canvas;
+    DrawScene(&view, prev, alpha, assets);
+    rasterTarget = NULL;
+
+    ProfileBegin("RasterTiles");
+    RasterEnd(canvas);
+    ProfileEnd();
+    ProfileEnd();
+}
+
+// The other player in a versus match, interpolated; set while DrawVersus is drawing
+static const Game *rivalView;
+
+void DrawVersus(const Game *prev, const Game *game, const Game *rivalPrev, const Game *rival, float alpha, const Assets *assets) {
+    Game view = *rival;
+    InterpolateBird(&view, rivalPrev, alpha);
+    rivalView = &view;
+    DrawGame(prev, game, alpha, assets);
+    rivalView = NULL;
+}
+
+void DrawGame(const Game *prev, const Game *game, float alpha, const Assets *assets) {
+    // The whole scene reaches the GPU as one texture
+    if (assets->backend == RENDER_SOFTWARE) {
+        RasterGame(assets->raster, prev, game, alpha, assets);
+        ProfileBegin("PresentRaster");
+        UpdateTexture(assets->rasterTexture, assets->raster->pixels);
+        DrawTexture(assets->rasterTexture, 0, 0, WHITE);
+        ProfileEnd();
+        return;
+    }
+
+    // Shallow copy: only the bird is modified, the pipes are read through the ring
+    ProfileBegin("DrawGame");
+    Game view = *game;
+    InterpolateBird(&view, prev, alpha);
+    DrawScene(&view, prev, alpha, assets);
+    ProfileEnd();
+}
+
+// World sprites are offset by hand rather than through BeginMode2D: a camera change
+// flushes the rlgl batch, and everything here is on the atlas, so the scene stays one draw call.
+static void DrawAtlasSprite(const Assets *assets, Rectangle src, Rectangle dst, Vector2 offset) {
+    dst.x += offset.x;
+    dst.y += offset.y;
+    DrawAtlasQuad(assets, src, dst, (Vector2){0, 0}, 0.0f, WHITE);
+}
+
+static void DrawScene(const Game *game, const Game *prev, float alpha, const Assets *assets) {
+    // Apply screen shake offset
+    Vector2 shake = game->shakeOffset;
+
+    DrawAtlasSprite(assets, assets->recBg, (Rectangle){ 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, shake);
+
+    // Pipe texture regions
+    Rectangle pipe = assets->recPipe;
+    Rectangle srcCap        = AtlasRect(pipe, 0, 0, PIPE_WIDTH, PIPE_CAP_HEIGHT);
+    Rectangle srcCapFlipped = AtlasRect(pipe, 0, PIPE_CAP_HEIGHT, PIPE_WIDTH, -PIPE_CAP_HEIGHT);
+
+    float pipeBodyHeight = pipe.height - PIPE_CAP_HEIGHT;
+    Rectangle srcBody        = AtlasRect(pipe, 0, PIPE_CAP_HEIGHT, PIPE_WIDTH, pipeBodyHeight);
+    Rectangle srcBodyFlipped = AtlasRect(pipe, 0, pipe.height, PIPE_WIDTH, -pipeBodyHeight);
+
+    // Draw pipes
+    ProfileBegin("DrawPipes");
+    for (int i = 0; i < game->pipes.count; i++) {
+        Pipe p = GetPipe(game, i);
+        p.top.x = p.bottom.x = InterpolatePipeX(prev, game, i, alpha);
+
+        float topBodyHeight = p.top.height - PIPE_CAP_HEIGHT;
+        if (topBodyHeight < 0) topBodyHeight = 0;
+
+        Rectangle dstTopBody = { p.top.x, p.top.y, PIPE_WIDTH, topBodyHeight };
+        DrawAtlasSprite(assets, srcBody, dstTopBody, shake);
+
+        Rectangle dstTopCap = { p.top.x, p.top.y + topBodyHeight, PIPE_WIDTH, PIPE_CAP_HEIGHT };
+        DrawAtlasSprite(assets, srcCap, dstTopCap, shake);
+
+        float bottomBodyHeight = p.bottom.height - PIPE_CAP_HEIGHT;
+        if (bottomBodyHeight < 0) bottomBodyHeight = 0;
+
+        Rectangle dstBottomCap = { p.bottom.x, p.bottom.y, PIPE_WIDTH, PIPE_CAP_HEIGHT };
+        DrawAtlasSprite(assets, srcCapFlipped, dstBottomCap, shake);
+
+        Rectangle dstBottomBody = { p.bottom.x, p.bottom.y + PIPE_CAP_HEIGHT, PIPE_WIDTH, bottomBodyHeight };
+        DrawAtlasSprite(assets, srcBodyFlipped, dstBottomBody, shake);
+    }
+
+    ProfileEnd();
+
+    ProfileBegin("DrawBird");
+    // The rival flies the same course behind the player's own bird, faded; a crashed one is gone
+    if (rivalView != NULL && rivalView->state != GAME_OVER) {
+        DrawBirdTinted(&rivalView->bird, assets, shake, Fade(WHITE, GHOST_ALPHA));
+    }
+    DrawBirdSprite(&game->bird, assets, shake);
+    ProfileEnd();
+
+    // UI (not affected by shake)
+    ProfileBegin("DrawHud");
+    Color uiColor = (Color){ 255, 230, 0, 255 };
+    Color shadow  = (Color){ 0, 0, 0, 160 };
+    Vector2 shadowOffset = { 2, 2 };
+
+    const TextLayout *scoreText = UiText(TEXT_SCORE, assets, TextFormat("SCORE: %d", game->score), 32.0f);
+    DrawShadowedText(scoreText, (Vector2){ 20, 20 }, shadowOffset, uiColor, shadow);
+
+    const TextLayout *bestText = UiText(TEXT_BEST, assets, TextFormat("BEST: %d", game->highScore), 20.0f);
+    DrawShadowedText(bestText, (Vector2){ 20, 60 }, shadowOffset, uiColor, shadow);
+
+    if (rivalView != NULL) {
+        const TextLayout *rivalText = UiText(TEXT_RIVAL, assets,
+            TextFormat((rivalView->state == GAME_OVER) ? "RIVAL: %d (OUT)" : "RIVAL: %d", rivalView->score), 20.0f);
+        DrawShadowedText(rivalText, (Vector2){ 20, 86 }, shadowOffset, uiColor, shadow);
+    }
+    
+    // Draw lives (hearts)
+    DrawLives(game, assets);
+    ProfileEnd();
+
+    // Overlays
+    ProfileBegin("DrawOverlay");
+    if (game->state == GAME_WAITING) {
+        DrawWaitingScreen(assets);
+    }
+
+    if (game->state == GAME_OVER) {
+        DrawGameOverScreen(assets);
+    }
+    
+    if (game->state == GAME_PAUSED) {
+        DrawPauseScreen(assets);
+    }
+    
+    if (game->state == GAME_SETTINGS) {
+        DrawSettingsScreen(game, assets);
+    }
+    
+    if (game->state == GAME_RESPAWN_COUNTDOWN) {
+        DrawRespawnCountdown(game, assets);
+    }
+    ProfileEnd();
+}
+
+// --- PROFILER OVERLAY ---
+// Debug text changes every frame, so it is drawn directly instead of through uiText
+#define PROFILER_TEXT_SIZE 16.0f
+#define PROFILER_LINE      18
+#define PROFILER_WIDTH     380
+#define PROFILER_COLUMN    210     // x of the numbers next to each scope name
+
+void DrawProfilerOverlay(const ProfileStats *stats, const Assets *assets) {
+    float x = SCREEN_WIDTH - PROFILER_WIDTH - 10;
+    float y = 10;
+    CaptureStats capture;
+    GetCaptureStats(&capture);
+    bool software = assets->backend == RENDER_SOFTWARE;
+    int lines = 6 + (capture.active ? 1 : 0) + (software ? 1 : 0) + stats->zoneCount;
+    DrawRectangle((int)x - 6, (int)y - 4, PROFILER_WIDTH + 12, lines * PROFILER_LINE + 8, Fade(BLACK, 0.7f));
+
+    Color text = WHITE;
+    Color dim  = LIGHTGRAY;
+    DrawTextEx(assets->font, TextFormat("FRAME p50 %.2f  p95 %.2f  p99 %.2f ms",
+               stats->frameP50, stats->frameP95, stats->frameP99),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+    DrawTextEx(assets->font, TextFormat("MAX %.2f ms over %d frames", stats->frameMax, stats->frames),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+    DrawTextEx(assets->font, TextFormat("DRAW CALLS %d (avg %.1f)", stats->drawCalls, stats->drawCallsMean),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+
+    // Input-to-audio latency of sound plays, from the mixer
+    MixerStats audio;
+    GetMixerStats(&audio);
+    DrawTextEx(assets->font, TextFormat("AUDIO %.1f ms (avg %.1f, max %.1f)  cut %d  lost %d",
+               audio.latencyLast, audio.latencyMean, audio.latencyMax, audio.stolen, audio.dropped),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+
+    // Flap press to the flip that showed it, and the frame work reserved while latching
+    InputStats input;
+    GetInputStats(&input);
+    DrawTextEx(assets->font, TextFormat("INPUT %.1f ms (avg %.1f, max %.1f)  budget %.1f ms  missed %d",
+               input.latencyLast, input.latencyMean, input.latencyMax, input.budget, input.missed),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+
+    // What low-power mode has saved on static screens (the overlay itself keeps it off)
+    PowerStats power;
+    GetPowerStats(&power);
+    DrawTextEx(assets->font, TextFormat("IDLE %.0f s  skipped %lld frames  saved %.1f s CPU",
+               power.idleSeconds, power.framesSkipped, power.cpuSaved),
+               (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+    y += PROFILER_LINE;
+
+    // Only while capturing: frames lost to a full buffer pool and the encoder's pace
+    if (capture.active) {
+        DrawTextEx(assets->font, TextFormat("CAPTURE %d frames  dropped %d  encoder %.0f fps",
+                   capture.captured, capture.dropped, capture.fps),
+                   (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+        y += PROFILER_LINE;
+    }
+
+    // Only with the software backend; its timings are the RasterGame scopes below
+    if (software) {
+        DrawTextEx(assets->font, TextFormat("SOFTWARE %d threads  %d quads",
+                   assets->raster->threads, assets->raster->quadCount),
+                   (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, text);
+        y += PROFILER_LINE;
+    }
+
+    // Per-scope time per frame, most expensive first
+    for (int i = 0; i < stats->zoneCount; i++) {
+        const ProfileZone *zone = &stats->zones[i];
+        DrawTextEx(assets->font, zone->name, (Vector2){ x, y }, PROFILER_TEXT_SIZE, 1, dim);
+        DrawTextEx(assets->font, TextFormat("%.3f ms  x%.1f", zone->msPerFrame, zone->callsPerFrame),
+                   (Vector2){ x + PROFILER_COLUMN, y }, PROFILER_TEXT_SIZE, 1, dim);
+        y += PROFILER_LINE;
+    }
+}
\ No newline at end of file
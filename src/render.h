@@ -0,0 +1,71 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "raylib.h"
+#include "game.h"
+#include "profiler.h"
+#include "loader.h"
+#include "mixer.h"
+#include "power.h"
+#include "input.h"
+#include "capture.h"
+#include "raster.h"
+
+// --- BACKENDS ---
+// RENDER_SOFTWARE rasterises the scene into a CPU framebuffer and presents it as one
+// texture upload, for machines where the GL driver is itself a software one
+typedef enum RenderBackend {
+    RENDER_GPU,
+    RENDER_SOFTWARE
+} RenderBackend;
+
+// --- ASSETS ---
+// GPU handles, owned by the interactive shell rather than the simulation. Sounds are
+// handed to the mixer as they load and are silent until then.
+// Every sprite and the font glyphs share one atlas texture, so a frame is submitted
+// as a single rlgl batch instead of one draw call per texture switch.
+typedef struct Assets {
+    Texture2D atlas;
+    Rectangle recBird;
+    Rectangle recPipe;
+    Rectangle recBg;
+    Rectangle recHeartFull;     // HUD hearts, baked from a pixel pattern at load
+    Rectangle recHeartEmpty;
+    Rectangle recWhite;     // solid texels used as the shapes texture for rectangles
+
+    Font font;              // font.ttf, or raylib's built-in font; glyph recs point into the atlas
+    Image atlasPixels;      // CPU copy of the atlas, sampled by the software backend
+
+    RenderBackend backend;
+    RasterCanvas *raster;   // SCREEN_WIDTH x SCREEN_HEIGHT, while the software backend is on
+    Texture2D rasterTexture;
+
+    AssetLoader loader;     // streams the real assets in behind the placeholders
+    bool loading;
+} Assets;
+
+// --- FUNCTION PROTOTYPES ---
+// Returns at once with placeholder sprites and the built-in font; the real assets are
+// read and decoded on a worker thread and uploaded by UpdateAssets as they arrive.
+void LoadAssets(Assets *assets, const Settings *settings);
+// Main thread, once per frame: uploads whatever finished loading since the last call
+void UpdateAssets(Assets *assets);
+void UnloadAssets(Assets *assets);
+
+// Draws the state `alpha` of the way from prev to game (0..1, fixed-step interpolation)
+void DrawGame(const Game *prev, const Game *game, float alpha, const Assets *assets);
+void DrawBirdSprite(const Bird *bird, const Assets *assets, Vector2 offset);
+// DrawGame for one side of a versus match, with the rival's bird as a faded ghost and
+// the rival's score under the player's
+void DrawVersus(const Game *prev, const Game *game, const Game *rivalPrev, const Game *rival, float alpha, const Assets *assets);
+// The same frame as DrawGame, into canvas->pixels. Touches no GL state, so it also
+// works without a window, e.g. to compare frames against stored images.
+void RasterGame(RasterCanvas *canvas, const Game *prev, const Game *game, float alpha, const Assets *assets);
+// Returns false, leaving the GPU backend on, if the framebuffer can't be set up
+bool SetRenderBackend(Assets *assets, RenderBackend backend);
+
+// Draw calls queued in the current frame's batch; read before EndDrawing flushes it
+int GetFrameDrawCalls(void);
+void DrawProfilerOverlay(const ProfileStats *stats, const Assets *assets);
+
+#endif // RENDER_H
@@ -0,0 +1,177 @@
+// src/replay.c
+#include "replay.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// --- RECORDING ---
+void ReplayBegin(Replay *replay, unsigned int seed) {
+    replay->seed = seed;
+    replay->tickCount = 0;
+    replay->flapCount = 0;
+    replay->finalScore = 0;
+    replay->finalLives = MAX_LIVES;
+}
+
+static void AppendFlap(Replay *replay, int tick) {
+    if (replay->flapCount == replay->flapCapacity) {
+        int capacity = replay->flapCapacity ? replay->flapCapacity * 2 : 256;
+        int *grown = realloc(replay->flapTicks, capacity * sizeof(int));
+        if (grown == NULL) return;
+        replay->flapTicks = grown;
+        replay->flapCapacity = capacity;
+    }
+    replay->flapTicks[replay->flapCount++] = tick;
+}
+
+// Call after every UpdateGame with the flap input that tick received. Only
+// ticks that advanced the run are kept; a new run restarts the recording.
+void ReplayRecordTick(Replay *replay, const Game *game, bool flap) {
+    if (game->seed != replay->seed || game->runTick < replay->tickCount) {
+        ReplayBegin(replay, game->seed);
+        replay->course = game->course.curve;
+    }
+    if (game->runTick != replay->tickCount + 1) return;
+
+    if (flap) AppendFlap(replay, replay->tickCount);
+    replay->tickCount++;
+    replay->finalScore = game->score;
+    replay->finalLives = game->lives;
+}
+
+// The run was put back to the end of run tick `tick`: drops what was recorded after it,
+// so the recording is still exactly the run as it now stands
+void ReplayRewind(Replay *replay, int tick) {
+    if (tick < 0) tick = 0;
+    if (tick >= replay->tickCount) return;
+    while (replay->flapCount > 0 && replay->flapTicks[replay->flapCount - 1] >= tick) replay->flapCount--;
+    replay->tickCount = tick;
+}
+
+void FreeReplay(Replay *replay) {
+    free(replay->flapTicks);
+    memset(replay, 0, sizeof(*replay));
+}
+
+// --- FILE I/O ---
+static void WriteU32(FILE *file, unsigned int value) {
+    unsigned char bytes[4] = {
+        (unsigned char)value, (unsigned char)(value >> 8),
+        (unsigned char)(value >> 16), (unsigned char)(value >> 24)
+    };
+    fwrite(bytes, 1, 4, file);
+}
+
+static bool ReadU32(FILE *file, unsigned int *value) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, file) != 4) return false;
+    *value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+    return true;
+}
+
+static void WriteVarint(FILE *file, unsigned int value) {
+    while (value >= 0x80) {
+        fputc((int)((value & 0x7F) | 0x80), file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static bool ReadVarint(FILE *file, unsigned int *value) {
+    unsigned int result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        result |= (unsigned int)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SaveReplay(const Replay *replay, const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (!file) return false;
+
+    unsigned char head[8] = { 'F', 'B', 'R', 'P', REPLAY_VERSION, (unsigned char)replay->course,
+                              (unsigned char)SIM_TICK_RATE, (unsigned char)((int)SIM_TICK_RATE >> 8) };
+    fwrite(head, 1, sizeof(head), file);
+    WriteU32(file, replay->seed);
+    WriteU32(file, (unsigned int)replay->tickCount);
+    WriteU32(file, (unsigned int)replay->flapCount);
+    WriteU32(file, (unsigned int)replay->finalScore);
+    WriteU32(file, (unsigned int)replay->finalLives);
+
+    // Flaps are sparse, so store the gap (run of idle ticks) before each one
+    int prev = -1;
+    for (int i = 0; i < replay->flapCount; i++) {
+        WriteVarint(file, (unsigned int)(replay->flapTicks[i] - prev - 1));
+        prev = replay->flapTicks[i];
+    }
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+bool LoadReplay(Replay *replay, const char *fileName) {
+    memset(replay, 0, sizeof(*replay));
+
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return false;
+
+    unsigned char head[8];
+    unsigned int seed, ticks, flaps, score, lives;
+    bool ok = fread(head, 1, sizeof(head), file) == sizeof(head) &&
+              memcmp(head, "FBRP", 4) == 0 && head[4] == REPLAY_VERSION && head[5] < COURSE_CURVES &&
+              (head[6] | (head[7] << 8)) == (int)SIM_TICK_RATE &&
+              ReadU32(file, &seed) && ReadU32(file, &ticks) && ReadU32(file, &flaps) &&
+              ReadU32(file, &score) && ReadU32(file, &lives) && flaps <= ticks;
+
+    if (ok) {
+        ReplayBegin(replay, seed);
+        replay->course = (CourseCurve)head[5];
+        replay->tickCount = (int)ticks;
+        replay->finalScore = (int)score;
+        replay->finalLives = (int)lives;
+
+        int tick = -1;
+        for (unsigned int i = 0; i < flaps && ok; i++) {
+            unsigned int gap;
+            ok = ReadVarint(file, &gap);
+            tick += (int)gap + 1;
+            if (ok) AppendFlap(replay, tick);
+        }
+        ok = ok && replay->flapCount == (int)flaps;
+    }
+
+    fclose(file);
+    if (!ok) FreeReplay(replay);
+    return ok;
+}
+
+// --- PLAYBACK ---
+void StartReplay(ReplayPlayer *player, const Replay *replay, Game *game) {
+    player->replay = replay;
+    player->nextFlap = 0;
+    game->course.curve = replay->course;
+    ResetGame(game, replay->seed);
+}
+
+// Advance one tick with the recorded input. Returns false once the recording is used up.
+bool StepReplay(ReplayPlayer *player, Game *game, GameEvents *events) {
+    const Replay *replay = player->replay;
+    if (game->runTick >= replay->tickCount || game->state == GAME_OVER) return false;
+
+    GameInput input = { 0 };
+    if (player->nextFlap < replay->flapCount &&
+        replay->flapTicks[player->nextFlap] == game->runTick) {
+        input.flap = true;
+        player->nextFlap++;
+    }
+
+    UpdateGame(game, &input, events, SIM_DT);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include "game.h"
+
+// --- REPLAY FORMAT ---
+// "FBRP" | version u8 | course curve u8 | tick rate u16 | seed u32 | ticks u32 |
+// flaps u32 | final score i32 | final lives i32 | one varint per flap holding
+// the number of non-flap ticks before it. All integers are little-endian.
+#define REPLAY_VERSION 2    // 2: swept collision
+
+// --- STRUCTURES ---
+typedef struct Replay {
+    unsigned int seed;      // run seed passed to ResetGame
+    CourseCurve course;     // 0 (CLASSIC) in recordings from before curves existed
+    int tickCount;          // run ticks covered by the recording
+    int *flapTicks;         // run tick of every flap, ascending
+    int flapCount;
+    int flapCapacity;
+
+    // Outcome when recording stopped, checked on playback
+    int finalScore;
+    int finalLives;
+} Replay;
+
+typedef struct ReplayPlayer {
+    const Replay *replay;
+    int nextFlap;
+} ReplayPlayer;
+
+// --- FUNCTION PROTOTYPES ---
+void ReplayBegin(Replay *replay, unsigned int seed);
+void ReplayRecordTick(Replay *replay, const Game *game, bool flap);
+void ReplayRewind(Replay *replay, int tick);
+void FreeReplay(Replay *replay);
+
+bool SaveReplay(const Replay *replay, const char *fileName);
+bool LoadReplay(Replay *replay, const char *fileName);
+
+void StartReplay(ReplayPlayer *player, const Replay *replay, Game *game);
+bool StepReplay(ReplayPlayer *player, Game *game, GameEvents *events);
+
+#endif // REPLAY_H
\ No newline at end of file
@@ -0,0 +1,204 @@
+// src/rewind.c
+#include "rewind.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REWIND_WORDS        (sizeof(GameSnapshot) / 4)
+#define REWIND_MASK_BYTES   ((REWIND_WORDS + 7) / 8)
+#define REWIND_HEADER       2
+#define REWIND_MAX_RECORD   (REWIND_HEADER + REWIND_MASK_BYTES + sizeof(GameSnapshot))
+#define REWIND_MIN_BUDGET   (2 * REWIND_KEYFRAME_TICKS * REWIND_MAX_RECORD + REWIND_MAX_RECORD)
+
+// --- DELTAS ---
+// A bit per 32-bit word of the snapshot, then the new value of each set word
+static size_t EncodeDelta(unsigned char *out, const GameSnapshot *key, const GameSnapshot *snapshot) {
+    const unsigned char *from = (const unsigned char *)key;
+    const unsigned char *to = (const unsigned char *)snapshot;
+    unsigned char *mask = out;
+    size_t size = REWIND_MASK_BYTES;
+
+    memset(mask, 0, REWIND_MASK_BYTES);
+    for (size_t w = 0; w < REWIND_WORDS; w++) {
+        if (memcmp(from + w * 4, to + w * 4, 4) == 0) continue;
+        mask[w >> 3] |= (unsigned char)(1u << (w & 7));
+        memcpy(out + size, to + w * 4, 4);
+        size += 4;
+    }
+    return size;
+}
+
+static void ApplyDelta(GameSnapshot *snapshot, const unsigned char *delta) {
+    unsigned char *to = (unsigned char *)snapshot;
+    const unsigned char *word = delta + REWIND_MASK_BYTES;
+
+    for (size_t i = 0; i < REWIND_MASK_BYTES; i++) {
+        if (delta[i] == 0) continue;
+        for (int bit = 0; bit < 8; bit++) {
+            if (!(delta[i] & (1u << bit))) continue;
+            memcpy(to + (i * 8 + bit) * 4, word, 4);
+            word += 4;
+        }
+    }
+}
+
+// --- RECORDS ---
+static size_t RecordSize(const RewindBuffer *rewind, size_t at) {
+    return rewind->data[at] | ((size_t)rewind->data[at + 1] << 8);
+}
+
+// Follows the wrap to the start of the ring, if the record at `at` is there
+static size_t RecordStart(const RewindBuffer *rewind, size_t at) {
+    if (rewind->capacity - at < REWIND_HEADER || RecordSize(rewind, at) == 0) return 0;
+    return at;
+}
+
+static size_t NextRecord(const RewindBuffer *rewind, size_t at) {
+    return RecordStart(rewind, at + REWIND_HEADER + RecordSize(rewind, at));
+}
+
+// Offset of the record for the tick `index` ticks after the oldest one held
+static size_t FindRecord(const RewindBuffer *rewind, int index) {
+    int group = index / REWIND_KEYFRAME_TICKS;
+    size_t at = rewind->keyframes[(rewind->keyHead + group) % rewind->keyCapacity];
+    for (int i = index % REWIND_KEYFRAME_TICKS; i > 0; i--) at = NextRecord(rewind, at);
+    return at;
+}
+
+static void DropOldestSecond(RewindBuffer *rewind) {
+    size_t tail = rewind->keyframes[rewind->keyHead];
+    rewind->keyHead = (rewind->keyHead + 1) % rewind->keyCapacity;
+    rewind->keyCount--;
+    rewind->firstTick += REWIND_KEYFRAME_TICKS;
+    rewind->tickCount -= REWIND_KEYFRAME_TICKS;
+
+    size_t next = rewind->keyframes[rewind->keyHead];
+    rewind->used -= (next > tail) ? next - tail : next + rewind->capacity - tail;
+}
+
+// Makes room for a record of `size` bytes, header included, dropping old seconds
+// (but never the one still being written unless this is its successor's keyframe)
+static bool ReserveRecord(RewindBuffer *rewind, size_t size, bool keyframe) {
+    bool wrap = rewind->capacity - rewind->write < size;
+    size_t skipped = wrap ? rewind->capacity - rewind->write : 0;
+    int keep = keyframe ? 0 : 1;
+    while (rewind->capacity - rewind->used < skipped + size) {
+        if (rewind->keyCount <= keep) return false;
+        if (rewind->keyCount == 1) {
+            ClearRewind(rewind);
+            return true;
+        }
+        DropOldestSecond(rewind);
+    }
+
+    if (wrap) {
+        if (skipped >= REWIND_HEADER) memset(rewind->data + rewind->write, 0, REWIND_HEADER);
+        rewind->used += skipped;
+        rewind->write = 0;
+    }
+    return true;
+}
+
+// --- BUFFER ---
+bool InitRewind(RewindBuffer *rewind, size_t budget) {
+    memset(rewind, 0, sizeof(*rewind));
+    if (budget < REWIND_MIN_BUDGET) budget = REWIND_MIN_BUDGET;
+
+    // Every second takes at least its keyframe
+    rewind->keyCapacity = (int)(budget / (REWIND_HEADER + sizeof(GameSnapshot))) + 2;
+    rewind->data = malloc(budget);
+    rewind->keyframes = malloc((size_t)rewind->keyCapacity * sizeof(size_t));
+    if (rewind->data == NULL || rewind->keyframes == NULL) {
+        FreeRewind(rewind);
+        return false;
+    }
+    rewind->capacity = budget;
+    return true;
+}
+
+void FreeRewind(RewindBuffer *rewind) {
+    free(rewind->data);
+    free(rewind->keyframes);
+    memset(rewind, 0, sizeof(*rewind));
+}
+
+void ClearRewind(RewindBuffer *rewind) {
+    rewind->write = 0;
+    rewind->used = 0;
+    rewind->keyHead = 0;
+    rewind->keyCount = 0;
+    rewind->tickCount = 0;
+}
+
+bool RewindPush(RewindBuffer *rewind, int tick, const GameSnapshot *snapshot) {
+    if (rewind->data == NULL) return false;
+    if (rewind->tickCount > 0 && tick != rewind->firstTick + rewind->tickCount) ClearRewind(rewind);
+    if (rewind->tickCount == 0) rewind->firstTick = tick;
+
+    bool keyframe = rewind->tickCount % REWIND_KEYFRAME_TICKS == 0;
+    unsigned char delta[REWIND_MASK_BYTES + sizeof(GameSnapshot)];
+    const unsigned char *payload = (const unsigned char *)snapshot;
+    size_t size = sizeof(GameSnapshot);
+    if (!keyframe) {
+        size = EncodeDelta(delta, &rewind->key, snapshot);
+        payload = delta;
+    }
+
+    if (!ReserveRecord(rewind, REWIND_HEADER + size, keyframe)) return false;
+    if (rewind->tickCount == 0) rewind->firstTick = tick;     // everything was dropped
+
+    unsigned char *record = rewind->data + rewind->write;
+    record[0] = (unsigned char)size;
+    record[1] = (unsigned char)(size >> 8);
+    memcpy(record + REWIND_HEADER, payload, size);
+
+    if (keyframe) {
+        rewind->keyframes[(rewind->keyHead + rewind->keyCount) % rewind->keyCapacity] = rewind->write;
+        rewind->keyCount++;
+        rewind->key = *snapshot;
+    }
+    rewind->write += REWIND_HEADER + size;
+    rewind->used += REWIND_HEADER + size;
+    rewind->tickCount++;
+    return true;
+}
+
+bool RewindLoad(const RewindBuffer *rewind, int tick, GameSnapshot *snapshot) {
+    int index = tick - rewind->firstTick;
+    if (index < 0 || index >= rewind->tickCount) return false;
+
+    size_t key = rewind->keyframes[(rewind->keyHead + index / REWIND_KEYFRAME_TICKS) % rewind->keyCapacity];
+    memcpy(snapshot, rewind->data + key + REWIND_HEADER, sizeof(GameSnapshot));
+    if (index % REWIND_KEYFRAME_TICKS != 0) {
+        ApplyDelta(snapshot, rewind->data + FindRecord(rewind, index) + REWIND_HEADER);
+    }
+    return true;
+}
+
+void RewindTruncate(RewindBuffer *rewind, int tick) {
+    int keep = tick - rewind->firstTick + 1;
+    if (keep >= rewind->tickCount) return;
+    if (keep <= 0) {
+        ClearRewind(rewind);
+        return;
+    }
+
+    size_t last = FindRecord(rewind, keep - 1);
+    size_t tail = rewind->keyframes[rewind->keyHead];
+    rewind->write = last + REWIND_HEADER + RecordSize(rewind, last);
+    rewind->used = (rewind->write > tail) ? rewind->write - tail : rewind->write + rewind->capacity - tail;
+    rewind->keyCount = (keep + REWIND_KEYFRAME_TICKS - 1) / REWIND_KEYFRAME_TICKS;
+    rewind->tickCount = keep;
+
+    // Deltas pushed from here on are against the keyframe of the second that is left open
+    size_t key = rewind->keyframes[(rewind->keyHead + rewind->keyCount - 1) % rewind->keyCapacity];
+    memcpy(&rewind->key, rewind->data + key + REWIND_HEADER, sizeof(GameSnapshot));
+}
+
+void GetRewindStats(const RewindBuffer *rewind, RewindStats *stats) {
+    stats->ticks = rewind->tickCount;
+    stats->seconds = rewind->tickCount / SIM_TICK_RATE;
+    stats->keyframes = rewind->keyCount;
+    stats->bytes = rewind->used;
+    stats->budget = rewind->capacity;
+    stats->bytesPerTick = (rewind->tickCount > 0) ? (double)rewind->used / rewind->tickCount : 0.0;
+}
@@ -0,0 +1,61 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "game.h"
+
+// --- REWIND CONSTANTS ---
+#define REWIND_KEYFRAME_TICKS   120                 // a full snapshot once per simulated second
+#define REWIND_BUDGET           (4 * 1024 * 1024)   // the game's buffer: over 10 minutes of play
+
+// --- STRUCTURES ---
+// Consecutive ticks of GameSnapshots in a fixed byte budget. Every REWIND_KEYFRAME_TICKS-th
+// tick is stored whole; the ticks in between store only the words that differ from that
+// keyframe, so any tick loads from two records. When the budget is used up the oldest
+// second is dropped.
+//
+// Records are a u16 payload size and the payload, in a byte ring. A record that doesn't
+// fit before the end of the ring goes to the start, behind a zero size (or behind fewer
+// than two bytes, which count as one).
+typedef struct RewindBuffer {
+    unsigned char *data;
+    size_t capacity;
+    size_t write;           // where the next record goes; may equal capacity
+    size_t used;            // from the oldest keyframe to write, skipped ring ends included
+
+    size_t *keyframes;      // offset of each stored keyframe, a ring, oldest at keyHead
+    int keyCapacity;
+    int keyHead;
+    int keyCount;
+
+    int firstTick;          // tick of the oldest snapshot held
+    int tickCount;
+    GameSnapshot key;       // newest keyframe, what the next deltas are taken against
+} RewindBuffer;
+
+typedef struct RewindStats {
+    int ticks;
+    double seconds;         // of simulation held
+    int keyframes;
+    size_t bytes;
+    size_t budget;
+    double bytesPerTick;
+} RewindStats;
+
+// --- FUNCTION PROTOTYPES ---
+// Budgets smaller than two worst-case seconds are raised to that
+bool InitRewind(RewindBuffer *rewind, size_t budget);
+void FreeRewind(RewindBuffer *rewind);
+void ClearRewind(RewindBuffer *rewind);
+
+// Ticks must follow on from the last one pushed; any other tick starts the buffer over
+bool RewindPush(RewindBuffer *rewind, int tick, const GameSnapshot *snapshot);
+// False if the tick has been dropped or not pushed yet
+bool RewindLoad(const RewindBuffer *rewind, int tick, GameSnapshot *snapshot);
+// Forgets every tick after `tick`, so pushing carries on from there
+void RewindTruncate(RewindBuffer *rewind, int tick);
+
+void GetRewindStats(const RewindBuffer *rewind, RewindStats *stats);
+
+#endif // REWIND_H
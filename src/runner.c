@@ -0,0 +1,267 @@
+// src/runner.c
+#define _POSIX_C_SOURCE 200809L
+#include "runner.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// --- WORK-STEALING SCHEDULER ---
+// Each worker owns a range of item indices packed as (begin << 32 | end) in one
+// atomic word. The owner claims RUNNER_CHUNK items from the front; an idle
+// worker steals the back half of a victim's range. Both are a single CAS.
+typedef struct Worker {
+    _Atomic unsigned long long range;
+    struct Scheduler *sched;
+    int index;
+    unsigned int victimRng;
+    pthread_t thread;
+    char pad[64];           // keeps neighbouring workers' ranges off this cache line
+} Worker;
+
+typedef struct Scheduler {
+    Worker *workers;
+    int count;
+    long long base;                 // item index of range offset 0
+    long long total;
+    _Atomic long long claimed;      // items taken by owners (stealing does not count)
+    _Atomic long long completed;
+    _Atomic long long ticks;
+    ParallelJob job;
+    void *user;
+} Scheduler;
+
+static unsigned long long PackRange(unsigned int begin, unsigned int end) {
+    return ((unsigned long long)begin << 32) | end;
+}
+
+static bool ClaimLocal(Worker *w, unsigned int *begin, unsigned int *end) {
+    unsigned long long r = atomic_load(&w->range);
+    for (;;) {
+        unsigned int b = (unsigned int)(r >> 32), e = (unsigned int)r;
+        if (b >= e) return false;
+        unsigned int n = (e - b < RUNNER_CHUNK) ? e - b : RUNNER_CHUNK;
+        if (atomic_compare_exchange_weak(&w->range, &r, PackRange(b + n, e))) {
+            *begin = b;
+            *end = b + n;
+            return true;
+        }
+    }
+}
+
+static bool StealFrom(Worker *thief, Worker *victim) {
+    unsigned long long r = atomic_load(&victim->range);
+    for (;;) {
+        unsigned int b = (unsigned int)(r >> 32), e = (unsigned int)r;
+        if (b >= e) return false;
+        unsigned int mid = b + (e - b) / 2;
+        if (atomic_compare_exchange_weak(&victim->range, &r, PackRange(b, mid))) {
+            atomic_store(&thief->range, PackRange(mid, e));
+            return true;
+        }
+    }
+}
+
+static void *WorkerMain(void *arg) {
+    Worker *self = arg;
+    Scheduler *s = self->sched;
+
+    while (atomic_load(&s->claimed) < s->total) {
+        unsigned int begin, end;
+        if (ClaimLocal(self, &begin, &end)) {
+            atomic_fetch_add(&s->claimed, end - begin);
+            long long ticks = s->job(s->base + begin, s->base + end, self->index, s->user);
+            atomic_fetch_add_explicit(&s->completed, end - begin, memory_order_relaxed);
+            atomic_fetch_add_explicit(&s->ticks, ticks, memory_order_relaxed);
+            continue;
+        }
+
+        // Out of local work: try every other worker once, starting at a random one
+        bool stole = false;
+        int start = (int)(NextRandom(&self->victimRng) % (unsigned int)s->count);
+        for (int i = 0; i < s->count && !stole; i++) {
+            Worker *victim = &s->workers[(start + i) % s->count];
+            if (victim != self) stole = StealFrom(self, victim);
+        }
+        if (!stole) sched_yield();
+    }
+    return NULL;
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int DefaultThreadCount(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    if (n > RUNNER_MAX_THREADS) n = RUNNER_MAX_THREADS;
+    return (int)n;
+}
+
+// Runs job over [0, count) on `threads` workers (0 = one per core). With a
+// label, progress and simulated ticks per second are printed to stderr.
+bool RunParallel(long long count, int threads, ParallelJob job, void *user, const char *label) {
+    if (count <= 0) return true;
+    if (threads <= 0) threads = DefaultThreadCount();
+    if (threads > RUNNER_MAX_THREADS) threads = RUNNER_MAX_THREADS;
+
+    Worker *workers = calloc((size_t)threads, sizeof(Worker));
+    if (workers == NULL) return false;
+
+    // Ranges are 32-bit, so very large counts run as consecutive passes
+    const long long maxPass = 0xFFFFFFFFLL;
+    bool ok = true;
+    double start = NowSeconds();
+
+    for (long long base = 0; base < count && ok; base += maxPass) {
+        long long total = (count - base < maxPass) ? count - base : maxPass;
+
+        Scheduler s = { .workers = workers, .count = threads, .base = base, .total = total,
+                        .job = job, .user = user };
+        atomic_init(&s.claimed, 0);
+        atomic_init(&s.completed, 0);
+        atomic_init(&s.ticks, 0);
+
+        for (int i = 0; i < threads; i++) {
+            unsigned int b = (unsigned int)(total * i / threads);
+            unsigned int e = (unsigned int)(total * (i + 1) / threads);
+            atomic_init(&workers[i].range, PackRange(b, e));
+            workers[i].sched = &s;
+            workers[i].index = i;
+            workers[i].victimRng = SeedRandom((unsigned int)i);
+        }
+
+        int started = 0;
+        for (; started < threads; started++) {
+            if (pthread_create(&workers[started].thread, NULL, WorkerMain, &workers[started]) != 0) break;
+        }
+        if (started == 0) {
+            ok = false;
+            break;
+        }
+
+        if (label != NULL) {
+            double lastReport = NowSeconds();
+            while (atomic_load(&s.completed) < total) {
+                struct timespec nap = { 0, 20 * 1000 * 1000 };
+                nanosleep(&nap, NULL);
+
+                double now = NowSeconds();
+                if (now - lastReport < 0.5) continue;
+                lastReport = now;
+
+                double elapsed = now - start;
+                long long done = base + atomic_load(&s.completed);
+                fprintf(stderr, "\r%s: %lld/%lld (%5.1f%%)  %.2f M ticks/s   ", label, done, count,
+                        100.0 * done / count, elapsed > 0.0 ? atomic_load(&s.ticks) / elapsed / 1e6 : 0.0);
+            }
+            fprintf(stderr, "\n");
+        }
+
+        for (int i = 0; i < started; i++) {
+            pthread_join(workers[i].thread, NULL);
+        }
+    }
+
+    free(workers);
+    return ok;
+}
+
+// --- CAMPAIGNS ---
+// Seeds depend only on the game index, so results never depend on which thread played it
+unsigned int CampaignGameSeed(unsigned int campaignSeed, long long index) {
+    return SeedRandom(campaignSeed ^ SeedRandom((unsigned int)index ^ (unsigned int)(index >> 32)));
+}
+
+GameResult PlayGame(unsigned int seed, int maxTicks, GameBot bot, void *botData) {
+    Game game;
+    InitGame(&game, seed);
+    ResetGame(&game, seed);
+
+    int ticks = 0;
+    while (game.state != GAME_OVER && (maxTicks <= 0 || ticks < maxTicks)) {
+        GameInput input;
+        GameEvents events;
+        events.count = 0;
+        bot(&game, &input, botData);
+        UpdateGame(&game, &input, &events, SIM_DT);
+        ticks++;
+    }
+
+    GameResult result = { game.score, ticks };
+    FreeGame(&game);
+    return result;
+}
+
+// One private accumulator per worker, padded so workers never share a cache line
+typedef struct WorkerStats {
+    CampaignStats stats;
+    char pad[64];
+} WorkerStats;
+
+typedef struct CampaignJob {
+    const Campaign *campaign;
+    WorkerStats *perWorker;         // merged once every thread has joined
+} CampaignJob;
+
+static unsigned long long MixResult(long long index, int score) {
+    unsigned long long x = (unsigned long long)index * 0x9E3779B97F4A7C15ull ^ (unsigned long long)score;
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    return x;
+}
+
+static long long PlayCampaignRange(long long first, long long last, int worker, void *user) {
+    CampaignJob *job = user;
+    const Campaign *c = job->campaign;
+    CampaignStats *stats = &job->perWorker[worker].stats;
+    long long ticks = 0;
+
+    for (long long i = first; i < last; i++) {
+        GameResult r = PlayGame(CampaignGameSeed(c->seed, i), c->maxTicks, c->bot, c->botData);
+
+        stats->games++;
+        stats->ticks += r.ticks;
+        stats->totalScore += r.score;
+        if (r.score > stats->bestScore) stats->bestScore = r.score;
+        stats->checksum += MixResult(i, r.score);
+        stats->histogram[r.score < CAMPAIGN_HISTOGRAM ? r.score : CAMPAIGN_HISTOGRAM - 1]++;
+        ticks += r.ticks;
+    }
+    return ticks;
+}
+
+bool RunCampaign(const Campaign *campaign, CampaignStats *stats) {
+    int threads = campaign->threads > 0 ? campaign->threads : DefaultThreadCount();
+    if (threads > RUNNER_MAX_THREADS) threads = RUNNER_MAX_THREADS;
+
+    WorkerStats *perWorker = calloc((size_t)threads, sizeof(WorkerStats));
+    if (perWorker == NULL) return false;
+
+    CampaignJob job = { campaign, perWorker };
+    bool ok = RunParallel(campaign->games, threads, PlayCampaignRange, &job,
+                          campaign->progress ? "games" : NULL);
+
+    // Every field is an integer sum/max, so the merge is exact in any order
+    memset(stats, 0, sizeof(*stats));
+    for (int t = 0; t < threads; t++) {
+        const CampaignStats *w = &perWorker[t].stats;
+        stats->games += w->games;
+        stats->ticks += w->ticks;
+        stats->totalScore += w->totalScore;
+        if (w->bestScore > stats->bestScore) stats->bestScore = w->bestScore;
+        stats->checksum += w->checksum;
+        for (int b = 0; b < CAMPAIGN_HISTOGRAM; b++) stats->histogram[b] += w->histogram[b];
+    }
+
+    free(perWorker);
+    return ok;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <stdbool.h>
+#include "game.h"
+#include "bot.h"
+
+// --- RUNNER CONSTANTS ---
+#define RUNNER_MAX_THREADS   256
+#define RUNNER_CHUNK         32      // items a worker claims from its own range at once
+#define CAMPAIGN_HISTOGRAM   64      // score buckets; the last one collects everything above
+
+// --- STRUCTURES ---
+// Processes items [first, last) on the given worker and returns simulation ticks run (for throughput)
+typedef long long (*ParallelJob)(long long first, long long last, int worker, void *user);
+
+typedef struct GameResult {
+    int score;
+    int ticks;
+} GameResult;
+
+typedef struct CampaignStats {
+    long long games;
+    long long ticks;
+    long long totalScore;
+    int bestScore;
+    unsigned long long checksum;    // order-independent fingerprint of every (game, score)
+    long long histogram[CAMPAIGN_HISTOGRAM];
+} CampaignStats;
+
+typedef struct Campaign {
+    long long games;
+    unsigned int seed;      // game i always plays CampaignGameSeed(seed, i)
+    int threads;            // 0 = one per core
+    int maxTicks;           // cap per game, 0 = play until GAME_OVER
+    GameBot bot;
+    void *botData;
+    bool progress;          // print progress/throughput to stderr
+} Campaign;
+
+// --- FUNCTION PROTOTYPES ---
+int DefaultThreadCount(void);
+bool RunParallel(long long count, int threads, ParallelJob job, void *user, const char *label);
+
+unsigned int CampaignGameSeed(unsigned int campaignSeed, long long index);
+GameResult PlayGame(unsigned int seed, int maxTicks, GameBot bot, void *botData);
+bool RunCampaign(const Campaign *campaign, CampaignStats *stats);
+
+#endif // RUNNER_H
\ No newline at end of file
@@ -0,0 +1,400 @@
+// src/store.c
+#define _POSIX_C_SOURCE 200809L
+#include "store.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <io.h>
+    // windows.h clashes with raylib.h (through game.h), so the one call needed is declared here
+    __declspec(dllimport) int __stdcall MoveFileExA(const char *from, const char *to, unsigned long flags);
+    #define MOVEFILE_REPLACE_EXISTING 0x1
+    #define MOVEFILE_WRITE_THROUGH    0x8
+#else
+    #include <unistd.h>
+#endif
+
+#define FILE_HEADER_SIZE   8
+#define RECORD_HEADER_SIZE 8
+#define RECORD_CRC_SIZE    4
+#define RECORD_MAX_SIZE    64
+
+// Record types and the current layout of each payload
+#define RECORD_SETTINGS    1
+#define SETTINGS_VERSION   2
+#define SETTINGS_SIZE      10   // music f32, sfx f32, screen shake u8, course curve u8
+#define SETTINGS_V1_SIZE   9    // without the course curve
+#define RECORD_STATS       2
+#define STATS_VERSION      1
+#define STATS_SIZE         28   // runs u64, total score u64, total ticks u64, high score i32
+
+#define RUN_RECORD_SIZE    24   // seed u32, score i32, ticks i32, end time i64, CRC-32
+
+// --- ENCODING ---
+// Little-endian throughout, independent of struct layout
+static void PutU16(unsigned char *bytes, unsigned int value) {
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+}
+
+static void PutU32(unsigned char *bytes, unsigned int value) {
+    for (int i = 0; i < 4; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutU64(unsigned char *bytes, unsigned long long value) {
+    for (int i = 0; i < 8; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+}
+
+static unsigned int GetU16(const unsigned char *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static unsigned int GetU32(const unsigned char *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+static unsigned long long GetU64(const unsigned char *bytes) {
+    return GetU32(bytes) | ((unsigned long long)GetU32(bytes + 4) << 32);
+}
+
+static void PutF32(unsigned char *bytes, float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PutU32(bytes, bits);
+}
+
+static float GetF32(const unsigned char *bytes) {
+    unsigned int bits = GetU32(bytes);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// CRC-32 (IEEE). Records are a few dozen bytes, so the bitwise form is fast enough.
+static unsigned int Crc32(const unsigned char *bytes, size_t size) {
+    unsigned int crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+static int EncodeHeader(unsigned char *out, const char *magic) {
+    memcpy(out, magic, 4);
+    PutU32(out + 4, STORE_VERSION);
+    return FILE_HEADER_SIZE;
+}
+
+// Frames a payload that was written at out + RECORD_HEADER_SIZE; returns the record size
+static int FinishRecord(unsigned char *out, unsigned int type, unsigned int version, int length) {
+    PutU16(out, type);
+    PutU16(out + 2, version);
+    PutU32(out + 4, (unsigned int)length);
+    PutU32(out + RECORD_HEADER_SIZE + length, Crc32(out, RECORD_HEADER_SIZE + length));
+    return RECORD_HEADER_SIZE + length + RECORD_CRC_SIZE;
+}
+
+static int EncodeSettings(unsigned char *out, const Settings *settings) {
+    unsigned char *payload = out + RECORD_HEADER_SIZE;
+    PutF32(payload, settings->musicVolume);
+    PutF32(payload + 4, settings->sfxVolume);
+    payload[8] = settings->screenShake ? 1 : 0;
+    payload[9] = (unsigned char)settings->course;
+    return FinishRecord(out, RECORD_SETTINGS, SETTINGS_VERSION, SETTINGS_SIZE);
+}
+
+static int EncodeStats(unsigned char *out, const LifetimeStats *stats) {
+    unsigned char *payload = out + RECORD_HEADER_SIZE;
+    PutU64(payload, (unsigned long long)stats->runs);
+    PutU64(payload + 8, (unsigned long long)stats->totalScore);
+    PutU64(payload + 16, (unsigned long long)stats->totalTicks);
+    PutU32(payload + 24, (unsigned int)stats->highScore);
+    return FinishRecord(out, RECORD_STATS, STATS_VERSION, STATS_SIZE);
+}
+
+static void EncodeRun(unsigned char *out, const RunSummary *run) {
+    PutU32(out, run->seed);
+    PutU32(out + 4, (unsigned int)run->score);
+    PutU32(out + 8, (unsigned int)run->ticks);
+    PutU64(out + 12, (unsigned long long)run->endTime);
+    PutU32(out + 20, Crc32(out, RUN_RECORD_SIZE - RECORD_CRC_SIZE));
+}
+
+// Records of an unknown type or version are skipped; they still had to pass the CRC
+static void ApplyRecord(Store *store, unsigned int type, unsigned int version,
+                        const unsigned char *payload, unsigned int length) {
+    bool settingsV1 = version == 1 && length == SETTINGS_V1_SIZE;
+    if (type == RECORD_SETTINGS && (settingsV1 || (version == SETTINGS_VERSION && length == SETTINGS_SIZE))) {
+        store->settings.musicVolume = GetF32(payload);
+        store->settings.sfxVolume = GetF32(payload + 4);
+        store->settings.screenShake = payload[8] != 0;
+        store->settings.course = (!settingsV1 && payload[9] < COURSE_CURVES) ? payload[9] : COURSE_CLASSIC;
+    } else if (type == RECORD_STATS && version == STATS_VERSION && length == STATS_SIZE) {
+        store->stats.runs = (long long)GetU64(payload);
+        store->stats.totalScore = (long long)GetU64(payload + 8);
+        store->stats.totalTicks = (long long)GetU64(payload + 16);
+        store->stats.highScore = (int)GetU32(payload + 24);
+    }
+}
+
+// --- LOADING ---
+// Replays the journal into store->settings/stats. False if there is no usable journal.
+static bool LoadJournal(Store *store) {
+    FILE *file = fopen(STORE_JOURNAL_FILE, "rb");
+    if (!file) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = (size > 0) ? malloc((size_t)size) : NULL;
+    bool ok = data != NULL && fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    ok = ok && size >= FILE_HEADER_SIZE && memcmp(data, "FBJN", 4) == 0 && GetU32(data + 4) == STORE_VERSION;
+    long offset = FILE_HEADER_SIZE;
+    while (ok && size - offset >= RECORD_HEADER_SIZE + RECORD_CRC_SIZE) {
+        const unsigned char *record = data + offset;
+        unsigned int length = GetU32(record + 4);
+        if (length > (unsigned long)(size - offset - RECORD_HEADER_SIZE - RECORD_CRC_SIZE)) break;
+        if (GetU32(record + RECORD_HEADER_SIZE + length) != Crc32(record, RECORD_HEADER_SIZE + length)) break;
+
+        ApplyRecord(store, GetU16(record), GetU16(record + 2), record + RECORD_HEADER_SIZE, length);
+        offset += RECORD_HEADER_SIZE + (long)length + RECORD_CRC_SIZE;
+    }
+    free(data);
+    if (!ok) return false;
+
+    // Anything after the last good record is cut off by rewriting the journal
+    store->journalSize = offset;
+    store->compactNeeded = offset != size || size > STORE_COMPACT_SIZE;
+    return true;
+}
+
+// Settings from before the journal: the struct as it was then, written as-is
+typedef struct LegacySettings {
+    float musicVolume;
+    float sfxVolume;
+    bool screenShake;
+} LegacySettings;
+
+static bool LoadLegacySettings(Settings *settings) {
+    FILE *file = fopen(STORE_LEGACY_FILE, "rb");
+    if (!file) return false;
+
+    LegacySettings legacy;
+    bool ok = fread(&legacy, sizeof(legacy), 1, file) == 1 && fgetc(file) == EOF;
+    fclose(file);
+    if (ok) {
+        settings->musicVolume = legacy.musicVolume;
+        settings->sfxVolume = legacy.sfxVolume;
+        settings->screenShake = legacy.screenShake;
+    }
+    return ok;
+}
+
+// --- WRITING ---
+// Pushes the file's data to the disk, not just to the OS
+static bool SyncFile(FILE *file) {
+    if (fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+static bool ReplaceFile(const char *from, const char *to) {
+#if defined(_WIN32)
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+// Writes the saved settings and stats as a fresh journal beside the old one, then
+// renames it over: a crash at any point leaves one complete journal or the other
+static bool CompactJournal(Store *store) {
+    if (store->journal) {
+        fclose(store->journal);
+        store->journal = NULL;
+    }
+
+    const char *tempFile = STORE_JOURNAL_FILE ".tmp";
+    FILE *file = fopen(tempFile, "wb");
+    if (!file) return false;
+
+    unsigned char buffer[FILE_HEADER_SIZE + 2 * RECORD_MAX_SIZE];
+    int size = EncodeHeader(buffer, "FBJN");
+    size += EncodeSettings(buffer + size, &store->savedSettings);
+    size += EncodeStats(buffer + size, &store->savedStats);
+    fwrite(buffer, 1, size, file);
+
+    bool ok = !ferror(file) && SyncFile(file);
+    fclose(file);
+    if (!ok || !ReplaceFile(tempFile, STORE_JOURNAL_FILE)) {
+        remove(tempFile);
+        return false;
+    }
+
+    store->journalSize = size;
+    store->compactNeeded = false;
+    return true;
+}
+
+static void AppendJournal(Store *store, const unsigned char *records, int size) {
+    if (!store->journal) store->journal = fopen(STORE_JOURNAL_FILE, "ab");
+    if (!store->journal) return;
+
+    fwrite(records, 1, size, store->journal);
+    SyncFile(store->journal);
+    store->journalSize += size;
+}
+
+// A record torn by a crash is padded out to a whole slot, so the ones after it stay
+// aligned; its CRC fails and readers skip it
+static void AppendRuns(const RunSummary *runs, int count) {
+    FILE *file = fopen(STORE_RUNS_FILE, "ab");
+    if (!file) return;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    unsigned char buffer[RUN_RECORD_SIZE];
+    if (size < FILE_HEADER_SIZE) {
+        // A new file, or one whose header was torn by a crash: start it over
+        fclose(file);
+        file = fopen(STORE_RUNS_FILE, "wb");
+        if (!file) return;
+        fwrite(buffer, 1, EncodeHeader(buffer, "FBRN"), file);
+    } else {
+        long torn = (size - FILE_HEADER_SIZE) % RUN_RECORD_SIZE;
+        if (torn > 0) {
+            memset(buffer, 0, sizeof(buffer));
+            fwrite(buffer, 1, RUN_RECORD_SIZE - torn, file);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        EncodeRun(buffer, &runs[i]);
+        fwrite(buffer, 1, RUN_RECORD_SIZE, file);
+    }
+    SyncFile(file);
+    fclose(file);
+}
+
+// Takes everything queued and writes it. The lock is held only while copying, so the
+// game thread never waits on the disk.
+static void WritePending(Store *store) {
+    RunSummary runs[STORE_RUN_QUEUE];
+
+    pthread_mutex_lock(&store->lock);
+    bool writeSettings = store->settingsDirty;
+    bool writeStats = store->statsDirty;
+    Settings settings = store->pendingSettings;
+    LifetimeStats stats = store->pendingStats;
+    int runCount = store->runCount;
+    memcpy(runs, store->runs, runCount * sizeof(RunSummary));
+    store->settingsDirty = false;
+    store->statsDirty = false;
+    store->runCount = 0;
+    pthread_mutex_unlock(&store->lock);
+
+    // Runs first: a crash before the stats record leaves the stats one run behind,
+    // never ahead of the history
+    if (runCount > 0) AppendRuns(runs, runCount);
+    if (writeSettings) store->savedSettings = settings;
+    if (writeStats) store->savedStats = stats;
+
+    if ((store->compactNeeded || store->journalSize > STORE_COMPACT_SIZE) && CompactJournal(store)) return;
+
+    unsigned char buffer[2 * RECORD_MAX_SIZE];
+    int size = 0;
+    if (writeSettings) size += EncodeSettings(buffer + size, &settings);
+    if (writeStats) size += EncodeStats(buffer + size, &stats);
+    if (size > 0) AppendJournal(store, buffer, size);
+}
+
+static bool HasPending(const Store *store) {
+    return store->settingsDirty || store->statsDirty || store->runCount > 0;
+}
+
+static void *StoreWriter(void *arg) {
+    Store *store = arg;
+    WritePending(store);    // compacts a damaged or imported journal straight away
+
+    pthread_mutex_lock(&store->lock);
+    for (;;) {
+        while (!HasPending(store) && !store->closing) pthread_cond_wait(&store->wake, &store->lock);
+        if (!HasPending(store)) break;
+
+        pthread_mutex_unlock(&store->lock);
+        WritePending(store);
+        pthread_mutex_lock(&store->lock);
+    }
+    pthread_mutex_unlock(&store->lock);
+    return NULL;
+}
+
+// --- GAME THREAD ---
+void OpenStore(Store *store) {
+    memset(store, 0, sizeof(*store));
+    DefaultSettings(&store->settings);
+
+    if (!LoadJournal(store)) {
+        LoadLegacySettings(&store->settings);
+        store->compactNeeded = true;    // writes the first journal
+    }
+    store->savedSettings = store->settings;
+    store->savedStats = store->stats;
+
+    pthread_mutex_init(&store->lock, NULL);
+    pthread_cond_init(&store->wake, NULL);
+    store->threadRunning = (pthread_create(&store->thread, NULL, StoreWriter, store) == 0);
+    if (!store->threadRunning) WritePending(store);
+}
+
+void StoreSettings(Store *store, const Settings *settings) {
+    store->settings = *settings;
+
+    pthread_mutex_lock(&store->lock);
+    store->pendingSettings = *settings;
+    store->settingsDirty = true;
+    pthread_cond_signal(&store->wake);
+    pthread_mutex_unlock(&store->lock);
+
+    if (!store->threadRunning) WritePending(store);
+}
+
+void StoreRun(Store *store, const RunSummary *run) {
+    LifetimeStats *stats = &store->stats;
+    stats->runs++;
+    stats->totalScore += run->score;
+    stats->totalTicks += run->ticks;
+    if (run->score > stats->highScore) stats->highScore = run->score;
+
+    pthread_mutex_lock(&store->lock);
+    store->pendingStats = *stats;
+    store->statsDirty = true;
+    if (store->runCount < STORE_RUN_QUEUE) store->runs[store->runCount++] = *run;
+    else store->droppedRuns++;
+    pthread_cond_signal(&store->wake);
+    pthread_mutex_unlock(&store->lock);
+
+    if (!store->threadRunning) WritePending(store);
+}
+
+void CloseStore(Store *store) {
+    if (store->threadRunning) {
+        pthread_mutex_lock(&store->lock);
+        store->closing = true;
+        pthread_cond_signal(&store->wake);
+        pthread_mutex_unlock(&store->lock);
+        pthread_join(store->thread, NULL);
+        store->threadRunning = false;
+    }
+
+    if (store->journal) fclose(store->journal);
+    store->journal = NULL;
+    pthread_mutex_destroy(&store->lock);
+    pthread_cond_destroy(&store->wake);
+}
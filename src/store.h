@@ -0,0 +1,78 @@
+#ifndef STORE_H
+#define STORE_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdio.h>
+#include "game.h"
+
+// --- STORE FILES ---
+// save.journal: "FBJN" | version u32 | records. A record is type u16 | version u16 |
+// length u32 | payload | CRC-32 of everything before it. Each save appends a record and
+// the newest of each type wins; replay stops at the first record that fails its check,
+// so a write torn by a crash loses only itself. Past STORE_COMPACT_SIZE the journal is
+// rewritten as one snapshot and swapped in with an atomic rename.
+//
+// runs.log: "FBRN" | version u32 | fixed-size run records, each with its own CRC. It is
+// only ever appended to and is not read at startup, so load time doesn't grow with it.
+#define STORE_JOURNAL_FILE  "save.journal"
+#define STORE_RUNS_FILE     "runs.log"
+#define STORE_LEGACY_FILE   "settings.dat"     // raw Settings struct, imported once
+#define STORE_VERSION       1
+#define STORE_COMPACT_SIZE  16384               // journal bytes before compaction
+#define STORE_RUN_QUEUE     64                  // run summaries waiting for the writer
+
+// --- STRUCTURES ---
+typedef struct LifetimeStats {
+    long long runs;
+    long long totalScore;
+    long long totalTicks;   // simulation ticks played
+    int highScore;
+} LifetimeStats;
+
+typedef struct RunSummary {
+    unsigned int seed;
+    int score;
+    int ticks;
+    long long endTime;      // seconds since the Unix epoch
+} RunSummary;
+
+// The game thread reads settings/stats and hands changes over; a writer thread does
+// all file I/O. Everything under `lock` is shared, the rest belongs to one side.
+typedef struct Store {
+    Settings settings;      // as loaded, then as last stored
+    LifetimeStats stats;
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    Settings pendingSettings;
+    LifetimeStats pendingStats;
+    bool settingsDirty;
+    bool statsDirty;
+    RunSummary runs[STORE_RUN_QUEUE];
+    int runCount;
+    int droppedRuns;        // summaries lost to a full queue (their stats are kept)
+    bool closing;
+
+    pthread_t thread;
+    bool threadRunning;
+
+    // Writer side
+    FILE *journal;
+    long journalSize;
+    bool compactNeeded;     // damaged tail, legacy import or oversized journal
+    Settings savedSettings;
+    LifetimeStats savedStats;
+} Store;
+
+// --- FUNCTION PROTOTYPES ---
+// Loads the journal (defaults if there is none) and starts the writer thread. If no
+// thread can be started, each store call writes before it returns.
+void OpenStore(Store *store);
+void StoreSettings(Store *store, const Settings *settings);
+// Folds the run into the lifetime stats and queues both for writing
+void StoreRun(Store *store, const RunSummary *run);
+// Writes whatever is still queued and stops the writer
+void CloseStore(Store *store);
+
+#endif // STORE_H
@@ -0,0 +1,78 @@
+// src/text.c
+#include "text.h"
+#include <string.h>
+
+// --- LAYOUT ---
+static void BuildTextLayout(TextLayout *layout) {
+    const Font *font = layout->font;
+    float scale = layout->size / (float)font->baseSize;
+    float padding = (float)font->glyphPadding;
+
+    float x = 0.0f, y = 0.0f;
+    float lineWidth = 0.0f;
+    int lines = 1;
+
+    layout->quadCount = 0;
+    layout->extent = (Vector2){ 0, 0 };
+
+    for (const char *c = layout->text; *c != '\0'; c++) {
+        if (*c == '\n') {
+            x = 0.0f;
+            y += layout->size;
+            lines++;
+            continue;
+        }
+
+        int index = GetGlyphIndex(*font, (unsigned char)*c);
+        const GlyphInfo *glyph = &font->glyphs[index];
+        Rectangle rec = font->recs[index];
+
+        // Same quad placement as DrawTextCodepoint, padding included so glyph edges aren't clipped
+        if (*c != ' ' && *c != '\t') {
+            TextQuad *quad = &layout->quads[layout->quadCount++];
+            quad->src = (Rectangle){
+                rec.x - padding, rec.y - padding,
+                rec.width + 2.0f * padding, rec.height + 2.0f * padding
+            };
+            quad->dst = (Rectangle){
+                x + (glyph->offsetX - padding) * scale, y + (glyph->offsetY - padding) * scale,
+                (rec.width + 2.0f * padding) * scale, (rec.height + 2.0f * padding) * scale
+            };
+        }
+
+        float advance = (glyph->advanceX != 0) ? (float)glyph->advanceX : rec.width;
+        x += advance * scale;
+        if (x > lineWidth) lineWidth = x;
+        x += layout->spacing;
+    }
+
+    layout->extent = (Vector2){ lineWidth, lines * layout->size };
+}
+
+bool UpdateTextLayout(TextLayout *layout, const Font *font, const char *text, float size, float spacing) {
+    if (layout->font == font && layout->size == size && layout->spacing == spacing &&
+        strncmp(layout->text, text, TEXT_MAX_LENGTH - 1) == 0) {
+        return false;
+    }
+
+    strncpy(layout->text, text, TEXT_MAX_LENGTH - 1);
+    layout->text[TEXT_MAX_LENGTH - 1] = '\0';
+    layout->font = font;
+    layout->size = size;
+    layout->spacing = spacing;
+
+    BuildTextLayout(layout);
+    return true;
+}
+
+// --- DRAWING ---
+void DrawTextLayout(const TextLayout *layout, Vector2 position, Color tint) {
+    if (layout->font == NULL) return;
+
+    for (int i = 0; i < layout->quadCount; i++) {
+        Rectangle dst = layout->quads[i].dst;
+        dst.x += position.x;
+        dst.y += position.y;
+        DrawTexturePro(layout->font->texture, layout->quads[i].src, dst, (Vector2){0, 0}, 0.0f, tint);
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+// --- RETAINED TEXT ---
+#define TEXT_MAX_LENGTH 64
+
+// One glyph quad; dst is relative to the layout's top-left corner
+typedef struct TextQuad {
+    Rectangle src;
+    Rectangle dst;
+} TextQuad;
+
+// A string laid out once and kept as ready-to-submit quads. It only gets rebuilt
+// when the text, size, spacing or font change.
+typedef struct TextLayout {
+    char text[TEXT_MAX_LENGTH];
+    const Font *font;
+    float size;
+    float spacing;
+
+    Vector2 extent;         // what MeasureTextEx would report
+    TextQuad quads[TEXT_MAX_LENGTH];
+    int quadCount;
+} TextLayout;
+
+// --- FUNCTION PROTOTYPES ---
+// Returns true if the layout had to be rebuilt. Text longer than TEXT_MAX_LENGTH - 1 is cut.
+bool UpdateTextLayout(TextLayout *layout, const Font *font, const char *text, float size, float spacing);
+void DrawTextLayout(const TextLayout *layout, Vector2 position, Color tint);
+
+#endif // TEXT_H
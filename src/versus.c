@@ -0,0 +1,269 @@
+// src/versus.c
+#define _POSIX_C_SOURCE 200809L
+#include "versus.h"
+#include <string.h>
+#include <time.h>
+
+#define VERSUS_MAGIC        "FBVS"
+#define VERSUS_VERSION      1
+#define VERSUS_HEADER_SIZE  28
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// --- STATE HASH ---
+// Over the fields rather than the bytes: padding in a Game is whatever was there before
+static unsigned int HashBytes(unsigned int hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int HashSnapshot(unsigned int hash, const GameSnapshot *snapshot) {
+    const Game *game = &snapshot->game;
+    int ints[] = { (int)game->state, game->runTick, game->score, game->lives,
+                   game->pipes.count, (int)game->pipes.spawned, (int)game->rng, game->course.index };
+    float floats[] = { game->bird.position.y, game->bird.velocity, game->bird.rotation,
+                       game->pipeSpawnTimer, game->respawnTimer };
+    hash = HashBytes(hash, ints, sizeof(ints));
+    hash = HashBytes(hash, floats, sizeof(floats));
+    hash = HashBytes(hash, snapshot->pipeX, sizeof(snapshot->pipeX));
+    hash = HashBytes(hash, snapshot->pipeGapTop, sizeof(snapshot->pipeGapTop));
+    return HashBytes(hash, snapshot->pipeScored, sizeof(snapshot->pipeScored));
+}
+
+static unsigned int HashPlayers(const GameSnapshot *first, const GameSnapshot *second) {
+    return HashSnapshot(HashSnapshot(2166136261u, first), second);
+}
+
+// --- SIMULATION ---
+static void SaveSnapshots(VersusMatch *match, int tick) {
+    int slot = tick & (VERSUS_SNAPSHOTS - 1);
+    SaveGameSnapshot(&match->snapshots[0][slot], &match->players[0]);
+    SaveGameSnapshot(&match->snapshots[1][slot], &match->players[1]);
+}
+
+static void LoadSnapshots(VersusMatch *match, int tick) {
+    int slot = tick & (VERSUS_SNAPSHOTS - 1);
+    for (int side = 0; side < 2; side++) {
+        LoadGameSnapshot(&match->players[side], &match->snapshots[side][slot]);
+        if (match->overTick[side] >= tick) match->overTick[side] = -1;
+    }
+}
+
+// A run that has ended stays ended: flapping on GAME_OVER would start a new one
+static void StepPlayers(VersusMatch *match, int tick, GameEvents *events) {
+    for (int side = 0; side < 2; side++) {
+        Game *game = &match->players[side];
+        if (game->state == GAME_OVER) continue;
+
+        GameInput input = { 0 };
+        input.flap = match->inputs[side][tick & (VERSUS_HISTORY - 1)];
+        GameEvents discarded = { 0 };
+        bool local = side == match->side && events != NULL;
+        UpdateGame(game, &input, local ? events : &discarded, SIM_DT);
+        if (game->state == GAME_OVER) match->overTick[side] = tick;
+    }
+}
+
+void InitVersus(VersusMatch *match, unsigned int seed, CourseCurve course, int side) {
+    memset(match, 0, sizeof(*match));
+    match->seed = seed;
+    match->course = course;
+    match->side = side;
+    match->remoteTick = -1;
+    match->peerAck = -1;
+    match->rollbackFrom = -1;
+    match->lastCheck = 0;
+    match->peerCheck = 0;
+    match->comparedCheck = 0;
+
+    for (int i = 0; i < 2; i++) {
+        InitGame(&match->players[i], seed);
+        match->players[i].course.curve = course;
+        ResetGame(&match->players[i], seed);
+        match->overTick[i] = -1;
+    }
+}
+
+void FreeVersus(VersusMatch *match) {
+    FreeGame(&match->players[0]);
+    FreeGame(&match->players[1]);
+}
+
+void SettleVersus(VersusMatch *match) {
+    int from = match->rollbackFrom;
+    if (from < 0) return;
+    match->rollbackFrom = -1;
+
+    double start = NowSeconds();
+    LoadSnapshots(match, from);
+    for (int t = from; t < match->tick; t++) {
+        if (t > from) SaveSnapshots(match, t);
+        StepPlayers(match, t, NULL);
+    }
+    double cost = NowSeconds() - start;
+
+    int depth = match->tick - from;
+    VersusStats *stats = &match->stats;
+    stats->rollbacks++;
+    stats->resimTicks += depth;
+    stats->resimSeconds += cost;
+    if (depth > stats->maxRollback) stats->maxRollback = depth;
+    if (cost > stats->maxResimSeconds) stats->maxResimSeconds = cost;
+}
+
+// --- DESYNC CHECKS ---
+static void CompareCheck(VersusMatch *match) {
+    int tick = match->peerCheck;
+    if (tick <= match->comparedCheck) return;
+
+    int slot = (tick / VERSUS_CHECK_TICKS) % VERSUS_CHECKS;
+    if (match->checkTicks[slot] != tick) return;
+    match->comparedCheck = tick;
+    match->stats.checks++;
+    if (match->checkHashes[slot] != match->peerHash) match->stats.desyncs++;
+}
+
+// The state before tick c is final once every input before c is known and simulated
+static void UpdateChecks(VersusMatch *match) {
+    int confirmed = (match->remoteTick < match->tick - 1) ? match->remoteTick : match->tick - 1;
+    int next = match->lastCheck + VERSUS_CHECK_TICKS;
+    if (next > confirmed + 1 || next >= match->tick) return;
+
+    int slot = next & (VERSUS_SNAPSHOTS - 1);
+    int check = (next / VERSUS_CHECK_TICKS) % VERSUS_CHECKS;
+    match->checkTicks[check] = next;
+    match->checkHashes[check] = HashPlayers(&match->snapshots[0][slot], &match->snapshots[1][slot]);
+    match->lastCheck = next;
+    CompareCheck(match);
+}
+
+bool AdvanceVersus(VersusMatch *match, bool flap, GameEvents *events) {
+    SettleVersus(match);
+    if (!match->connected || match->tick - match->remoteTick > VERSUS_MAX_ROLLBACK) {
+        match->stats.stalls++;
+        return false;
+    }
+
+    int slot = match->tick & (VERSUS_HISTORY - 1);
+    match->inputs[match->side][slot] = flap;
+    // Flaps are single presses, so "no flap" is the best guess for almost every tick
+    if (match->tick > match->remoteTick) match->inputs[1 - match->side][slot] = false;
+
+    SaveSnapshots(match, match->tick);
+    StepPlayers(match, match->tick, events);
+    match->tick++;
+    match->stats.ticks++;
+    UpdateChecks(match);
+    return true;
+}
+
+bool VersusFinished(const VersusMatch *match) {
+    int remote = 1 - match->side;
+    return match->overTick[match->side] >= 0 && match->overTick[remote] >= 0 &&
+           match->overTick[remote] <= match->remoteTick && match->rollbackFrom < 0;
+}
+
+unsigned int VersusChecksum(const VersusMatch *match) {
+    GameSnapshot first, second;
+    SaveGameSnapshot(&first, &match->players[0]);
+    SaveGameSnapshot(&second, &match->players[1]);
+    return HashPlayers(&first, &second);
+}
+
+// --- PACKETS ---
+// "FBVS" | version u8 | side u8 | course u8 | seed u32 | ack i32 | check tick i32 |
+// check hash u32 | first tick i32 | count u8 | one bit per input. Little-endian.
+static void PutU32(unsigned char *out, unsigned int value) {
+    out[0] = (unsigned char)value;
+    out[1] = (unsigned char)(value >> 8);
+    out[2] = (unsigned char)(value >> 16);
+    out[3] = (unsigned char)(value >> 24);
+}
+
+static unsigned int GetU32(const unsigned char *in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((unsigned int)in[3] << 24);
+}
+
+int WriteVersusPacket(const VersusMatch *match, unsigned char *packet) {
+    int first = match->peerAck + 1;
+    if (first < match->tick - VERSUS_PACKET_INPUTS) first = match->tick - VERSUS_PACKET_INPUTS;
+    int count = match->tick - first;
+
+    memcpy(packet, VERSUS_MAGIC, 4);
+    packet[4] = VERSUS_VERSION;
+    packet[5] = (unsigned char)match->side;
+    packet[6] = (unsigned char)match->course;
+    PutU32(packet + 7, match->seed);
+    PutU32(packet + 11, (unsigned int)match->remoteTick);
+    PutU32(packet + 15, (unsigned int)match->lastCheck);
+    int slot = (match->lastCheck / VERSUS_CHECK_TICKS) % VERSUS_CHECKS;
+    PutU32(packet + 19, (match->lastCheck > 0) ? match->checkHashes[slot] : 0);
+    PutU32(packet + 23, (unsigned int)first);
+    packet[27] = (unsigned char)count;
+
+    unsigned char *bits = packet + VERSUS_HEADER_SIZE;
+    memset(bits, 0, VERSUS_PACKET_SIZE - VERSUS_HEADER_SIZE);
+    for (int i = 0; i < count; i++) {
+        if (match->inputs[match->side][(first + i) & (VERSUS_HISTORY - 1)]) bits[i >> 3] |= (unsigned char)(1u << (i & 7));
+    }
+    return VERSUS_HEADER_SIZE + (count + 7) / 8;
+}
+
+bool ReadVersusHeader(const unsigned char *packet, int size, unsigned int *seed, CourseCurve *course, int *side) {
+    if (size < VERSUS_HEADER_SIZE || memcmp(packet, VERSUS_MAGIC, 4) != 0 || packet[4] != VERSUS_VERSION) return false;
+    if (packet[5] > 1 || packet[6] >= COURSE_CURVES) return false;
+    *side = packet[5];
+    *course = (CourseCurve)packet[6];
+    *seed = GetU32(packet + 7);
+    return true;
+}
+
+bool ReceiveVersusPacket(VersusMatch *match, const unsigned char *packet, int size) {
+    unsigned int seed;
+    CourseCurve course;
+    int side;
+    if (!ReadVersusHeader(packet, size, &seed, &course, &side)) return false;
+    if (side == match->side || seed != match->seed || course != match->course) return false;
+
+    int ack = (int)GetU32(packet + 11);
+    int check = (int)GetU32(packet + 15);
+    unsigned int hash = GetU32(packet + 19);
+    int first = (int)GetU32(packet + 23);
+    int count = packet[27];
+    if (count > VERSUS_PACKET_INPUTS || size < VERSUS_HEADER_SIZE + (count + 7) / 8) return false;
+
+    match->connected = true;
+    if (ack > match->peerAck) match->peerAck = ack;
+    if (check > match->peerCheck) {
+        match->peerCheck = check;
+        match->peerHash = hash;
+        CompareCheck(match);
+    }
+
+    // Inputs join the known run only in order; a gap means a newer packet will resend them
+    const unsigned char *bits = packet + VERSUS_HEADER_SIZE;
+    int remote = 1 - match->side;
+    for (int i = 0; i < count; i++) {
+        int tick = first + i;
+        if (tick <= match->remoteTick) continue;
+        if (tick != match->remoteTick + 1) break;
+
+        bool flap = (bits[i >> 3] >> (i & 7)) & 1;
+        int slot = tick & (VERSUS_HISTORY - 1);
+        if (tick < match->tick && match->inputs[remote][slot] != flap) {
+            match->stats.mispredicted++;
+            if (match->rollbackFrom < 0 || tick < match->rollbackFrom) match->rollbackFrom = tick;
+        }
+        match->inputs[remote][slot] = flap;
+        match->remoteTick = tick;
+    }
+    return true;
+}
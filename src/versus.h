@@ -0,0 +1,85 @@
+#ifndef VERSUS_H
+#define VERSUS_H
+
+#include <stdbool.h>
+#include "game.h"
+
+// --- VERSUS CONSTANTS ---
+#define VERSUS_MAX_ROLLBACK     8       // ticks either side may run on predicted input
+#define VERSUS_SNAPSHOTS        16      // saved states, power of two above VERSUS_MAX_ROLLBACK
+#define VERSUS_HISTORY          128     // input ring, power of two; covers a rollback plus a slow round trip
+#define VERSUS_CHECK_TICKS      120     // the two sides compare a state hash once per simulated second
+#define VERSUS_CHECKS           4       // own hashes kept for the peer's to catch up with
+#define VERSUS_PACKET_INPUTS    64      // most inputs one packet carries
+#define VERSUS_PACKET_SIZE      36      // header 28 bytes, then a bit per input
+
+// --- STRUCTURES ---
+typedef struct VersusStats {
+    long long ticks;            // simulated forward, re-simulation not counted
+    long long stalls;           // AdvanceVersus calls refused, waiting on the peer's input
+    long long mispredicted;     // peer inputs that differed from the prediction
+    long long rollbacks;
+    long long resimTicks;
+    int maxRollback;            // deepest rollback, in ticks
+    double resimSeconds;
+    double maxResimSeconds;     // slowest single rollback
+    long long checks;           // state hashes compared with the peer's
+    long long desyncs;          // ...that differed
+} VersusStats;
+
+// Two players racing the same seeded course, each in its own Game, stepped together.
+// Only the local player's input is known when a tick is simulated; the peer's is
+// predicted (no flap) until it arrives. A wrong prediction loads the state saved before
+// that tick and re-simulates up to the present with the real input.
+typedef struct VersusMatch {
+    unsigned int seed;
+    CourseCurve course;
+    int side;                   // 0 hosts and picks the seed, 1 joins; players[side] is local
+    bool connected;             // a packet from the peer has arrived
+
+    Game players[2];
+    int tick;                   // next tick to simulate
+    int overTick[2];            // tick each player's run ended on, -1 while still alive
+
+    bool inputs[2][VERSUS_HISTORY];             // flap per tick, by tick & (VERSUS_HISTORY - 1)
+    GameSnapshot snapshots[2][VERSUS_SNAPSHOTS];    // state before each tick
+    int remoteTick;             // peer's inputs are known up to here, -1 before any
+    int peerAck;                // our inputs the peer has, up to here
+    int rollbackFrom;           // earliest tick simulated on a wrong prediction, -1 if none
+
+    int checkTicks[VERSUS_CHECKS];
+    unsigned int checkHashes[VERSUS_CHECKS];
+    int lastCheck;              // newest tick hashed here
+    int peerCheck;              // newest tick the peer has hashed
+    unsigned int peerHash;
+    int comparedCheck;
+
+    VersusStats stats;
+} VersusMatch;
+
+// --- FUNCTION PROTOTYPES ---
+// Both players start running straight away on the same seed and course
+void InitVersus(VersusMatch *match, unsigned int seed, CourseCurve course, int side);
+void FreeVersus(VersusMatch *match);
+
+// Settles any rollback, then simulates one tick with the local flap. Refuses (returns
+// false) until the peer is connected, and while the peer's input is VERSUS_MAX_ROLLBACK
+// ticks behind. Events are the local player's only, and never from re-simulation.
+bool AdvanceVersus(VersusMatch *match, bool flap, GameEvents *events);
+// Re-simulates from the earliest wrong prediction, if packets have shown one
+void SettleVersus(VersusMatch *match);
+
+// Seed, course, sides, acknowledgement, the newest state hash and every local input
+// the peer hasn't acknowledged, up to VERSUS_PACKET_INPUTS. Returns the size.
+int WriteVersusPacket(const VersusMatch *match, unsigned char *packet);
+// Enough of any packet for the joining side to learn the match before InitVersus
+bool ReadVersusHeader(const unsigned char *packet, int size, unsigned int *seed, CourseCurve *course, int *side);
+// False for anything that isn't a packet from this match's peer
+bool ReceiveVersusPacket(VersusMatch *match, const unsigned char *packet, int size);
+
+// Both runs have ended and the peer's end is confirmed, not predicted
+bool VersusFinished(const VersusMatch *match);
+// Hash of both players' simulation state, equal on both sides once their inputs agree
+unsigned int VersusChecksum(const VersusMatch *match);
+
+#endif // VERSUS_H
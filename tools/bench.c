@@ -0,0 +1,527 @@
+// tools/bench.c
+// Microbenchmarks for the simulation core's hot paths. Prints ns/op, ops/s and
+// allocations per op, writes the results as JSON, and exits non-zero if any
+// benchmark is slower (or allocates more) than a stored baseline allows.
+//
+//   gcc tools/bench.c -Isrc -O2 -ffp-contract=off -lm -lpthread -o flappy_bench
+//   ./flappy_bench [results.json] [baseline.json] [margin %] [seconds per benchmark]
+//
+// The core sources are compiled into this file rather than linked, so their
+// malloc calls can be counted and their static helpers benchmarked.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// --- ALLOCATION COUNTING ---
+static long long allocCount;
+
+static void *CountedMalloc(size_t size) {
+    allocCount++;
+    return malloc(size);
+}
+
+// The core allocates through malloc only (the pipe ring, the journal buffer)
+#define malloc(size) CountedMalloc(size)
+#include "game.c"
+#include "player.c"
+#include "course.c"
+#include "bot.c"
+#include "store.c"
+#include "rewind.c"
+#undef malloc
+
+#define BENCH_REPEATS     5         // passes over the whole suite, each with a fresh setup
+#define BENCH_ROUNDS      5         // timed rounds per benchmark in each pass; the fastest counts
+#define BENCH_MAX_RESULTS 16
+#define BENCH_SEED        1u
+#define SCRIPT_TICKS      65536     // length of the recorded input script (power of two)
+#define HISTORY_TICKS     4096      // consecutive snapshots fed to the rewind benchmarks (power of two)
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Results are folded into this so the compiler can't drop the work
+static volatile float benchSink;
+
+// --- BENCHMARKS ---
+// Each runs `ops` operations on state prepared by its setup; setup and teardown
+// are not timed.
+typedef struct Benchmark {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(long long ops);
+    void (*teardown)(void);
+} Benchmark;
+
+static Game game;
+static Game start;
+static Bird bird;
+static bool script[SCRIPT_TICKS];
+
+// A game some way into a run, with a realistic set of pipes on screen
+static void SetupRunningGame(void) {
+    InitGame(&game, BENCH_SEED);
+    ResetGame(&game, BENCH_SEED);
+    game.lives = MAX_LIVES;
+
+    for (int t = 0; t < 1200 && game.state == GAME_RUNNING; t++) {
+        GameInput input;
+        GameEvents events = { 0 };
+        AutopilotBot(&game, &input, NULL);
+        UpdateGame(&game, &input, &events, SIM_DT);
+    }
+}
+
+static void TeardownGame(void) {
+    FreeGame(&game);
+}
+
+// UpdateBird: gravity, clamp and tilt, flapping whenever the bird drops below the middle
+static void SetupBird(void) {
+    InitBird(&bird);
+}
+
+static void RunUpdateBird(long long ops) {
+    float travel = 0.0f;
+    for (long long i = 0; i < ops; i++) {
+        if (bird.position.y > SCREEN_HEIGHT / 2.0f) BirdFlap(&bird);
+        travel += UpdateBird(&bird, SIM_DT);
+    }
+    benchSink = travel;
+}
+
+// SpawnPipe: the ring is emptied by hand before it fills, so it never has to grow
+static void SetupSpawnPipe(void) {
+    InitGame(&game, BENCH_SEED);
+}
+
+static void RunSpawnPipe(long long ops) {
+    for (long long i = 0; i < ops; i++) {
+        if (game.pipes.count == game.pipes.capacity) ClearPipes(&game.pipes);
+        SpawnPipe(&game);
+    }
+    benchSink = game.pipes.gapTop[game.pipes.head];
+}
+
+// The running tick's pipe loop: scroll every live pipe and sweep the bird against each.
+// The scroll alternates direction so the pipes stay on screen.
+static void RunPipeLoop(long long ops) {
+    PipeRing *ring = &game.pipes;
+    float scroll = PIPE_SPEED * SIM_DT;
+    Rectangle birdTo = BirdGetRect(&game.bird);
+    Rectangle birdFrom = birdTo;
+    birdFrom.y -= 2.0f;
+    Vector2 motion = { scroll, 2.0f };
+
+    int hits = 0;
+    for (long long i = 0; i < ops; i++) {
+        ScrollPipes(ring, (i & 1) ? -scroll : scroll);
+        for (int j = 0; j < ring->count; j++) {
+            float toi;
+            hits += SweepPipe(ring, PipeSlot(ring, j), birdFrom, motion, birdTo, &toi);
+        }
+    }
+    benchSink = (float)hits;
+}
+
+// BirdGetRect plus the narrow-phase tests against the next pipe and the bounds
+static void RunBirdCollision(long long ops) {
+    Bird probe = game.bird;
+    float baseY = probe.position.y;
+    int next = NextPipeAhead(&game);
+    Pipe pipe = GetPipe(&game, (next >= 0) ? next : 0);
+
+    int hits = 0;
+    for (long long i = 0; i < ops; i++) {
+        probe.position.y = baseY + (float)(i & 63) - 32.0f;
+        Rectangle rect = BirdGetRect(&probe);
+        Vector2 motion = { PIPE_SPEED * SIM_DT, 2.0f };
+
+        float toi;
+        hits += SweepRects(rect, motion, pipe.top, &toi);
+        hits += SweepRects(rect, motion, pipe.bottom, &toi);
+        hits += BirdSweepWorld(&probe, probe.position.y - 2.0f, 2.0f, &toi);
+    }
+    benchSink = (float)hits;
+}
+
+// Whole UpdateGame ticks replaying a fixed flap script recorded from the autopilot,
+// restarting from the same game every SCRIPT_TICKS ticks
+static void SetupScriptedGame(void) {
+    InitGame(&start, BENCH_SEED);
+    InitGame(&game, BENCH_SEED);
+
+    for (int t = 0; t < SCRIPT_TICKS; t++) {
+        GameInput input;
+        GameEvents events = { 0 };
+        AutopilotBot(&game, &input, NULL);
+        script[t] = input.flap;
+        UpdateGame(&game, &input, &events, SIM_DT);
+    }
+    CopyGame(&game, &start);
+}
+
+static void RunScriptedTicks(long long ops) {
+    GameInput input = { 0 };
+    GameEvents events;
+    int score = 0;
+
+    for (long long i = 0; i < ops; i++) {
+        int t = (int)(i & (SCRIPT_TICKS - 1));
+        if (t == 0) CopyGame(&game, &start);
+
+        input.flap = script[t];
+        events.count = 0;
+        UpdateGame(&game, &input, &events, SIM_DT);
+        score += game.score;
+    }
+    benchSink = (float)score;
+}
+
+static void TeardownScriptedGame(void) {
+    FreeGame(&game);
+    FreeGame(&start);
+}
+
+// Snapshots of a running game: one save, or one load back into a game with pipe storage
+static GameSnapshot snapshot;
+
+static void RunSaveSnapshot(long long ops) {
+    for (long long i = 0; i < ops; i++) {
+        game.bird.position.y = (float)(i & 255);
+        SaveGameSnapshot(&snapshot, &game);
+    }
+    benchSink = snapshot.pipeX[0];
+}
+
+static void SetupLoadSnapshot(void) {
+    SetupRunningGame();
+    SaveGameSnapshot(&snapshot, &game);
+}
+
+static void RunLoadSnapshot(long long ops) {
+    int ok = 0;
+    for (long long i = 0; i < ops; i++) ok += LoadGameSnapshot(&game, &snapshot);
+    benchSink = (float)ok + game.bird.position.y;
+}
+
+// The rewind buffer fed consecutive ticks of an autopilot run, at the game's budget,
+// so RewindPush drops old seconds as it does ten minutes into a run
+static GameSnapshot *history;
+static RewindBuffer rewindBuffer;
+static int historyTick;
+
+static void SetupRewind(void) {
+    history = malloc(HISTORY_TICKS * sizeof(GameSnapshot));
+    if (history == NULL || !InitRewind(&rewindBuffer, REWIND_BUDGET)) {
+        fprintf(stderr, "rewind benchmark: out of memory\n");
+        exit(1);
+    }
+
+    InitGame(&game, BENCH_SEED);
+    ResetGame(&game, BENCH_SEED);
+    for (int t = 0; t < HISTORY_TICKS; t++) {
+        GameInput input;
+        GameEvents events = { 0 };
+        AutopilotBot(&game, &input, NULL);
+        UpdateGame(&game, &input, &events, SIM_DT);
+        game.lives = MAX_LIVES;
+        SaveGameSnapshot(&history[t], &game);
+        RewindPush(&rewindBuffer, t, &history[t]);
+    }
+    historyTick = HISTORY_TICKS;
+}
+
+static void RunRewindPush(long long ops) {
+    int ok = 0;
+    for (long long i = 0; i < ops; i++, historyTick++) {
+        ok += RewindPush(&rewindBuffer, historyTick, &history[historyTick & (HISTORY_TICKS - 1)]);
+    }
+    benchSink = (float)ok;
+}
+
+// Scattered ticks, so the keyframe and the walk to the delta are rarely in cache
+static void RunRewindLoad(long long ops) {
+    int ok = 0;
+    for (long long i = 0; i < ops; i++) {
+        int tick = rewindBuffer.firstTick + (int)((i * 7919) % rewindBuffer.tickCount);
+        ok += RewindLoad(&rewindBuffer, tick, &snapshot);
+    }
+    benchSink = (float)ok + snapshot.game.bird.position.y;
+}
+
+static void TeardownRewind(void) {
+    FreeRewind(&rewindBuffer);
+    free(history);
+    FreeGame(&game);
+}
+
+// The store benchmarks run in a scratch directory, so the player's save files are untouched
+#define STORE_SCRATCH "/tmp/flappy_bench_XXXXXX"
+
+static char storeDir[sizeof(STORE_SCRATCH)];
+static char homeDir[4096];
+static Store benchStore;
+
+static void EnterScratchDir(void) {
+    memcpy(storeDir, STORE_SCRATCH, sizeof(STORE_SCRATCH));
+    if (getcwd(homeDir, sizeof(homeDir)) == NULL || mkdtemp(storeDir) == NULL || chdir(storeDir) != 0) {
+        fprintf(stderr, "store benchmark: no scratch directory\n");
+        exit(1);
+    }
+}
+
+static void LeaveScratchDir(void) {
+    remove(STORE_JOURNAL_FILE);
+    remove(STORE_JOURNAL_FILE ".tmp");
+    if (chdir(homeDir) != 0) fprintf(stderr, "store benchmark: could not return to %s\n", homeDir);
+    rmdir(storeDir);
+}
+
+// Replays a journal grown to the compaction threshold, the most the game ever reads at startup
+static void SetupStoreLoad(void) {
+    EnterScratchDir();
+
+    FILE *file = fopen(STORE_JOURNAL_FILE, "wb");
+    if (!file) {
+        fprintf(stderr, "store benchmark: could not write %s\n", STORE_JOURNAL_FILE);
+        exit(1);
+    }
+    unsigned char record[RECORD_MAX_SIZE];
+    long size = EncodeHeader(record, "FBJN");
+    fwrite(record, 1, size, file);
+
+    LifetimeStats stats = { 0 };
+    while (size < STORE_COMPACT_SIZE) {
+        stats.runs++;
+        int length = EncodeStats(record, &stats);
+        fwrite(record, 1, length, file);
+        size += length;
+    }
+    fclose(file);
+}
+
+static void RunStoreLoad(long long ops) {
+    for (long long i = 0; i < ops; i++) LoadJournal(&benchStore);
+    benchSink = (float)benchStore.stats.runs;
+}
+
+// What the writer thread does for one StoreSettings: take the dirty settings, encode the
+// record and append it to the journal with its sync, compacting whenever it grows too big
+static void SetupStoreSave(void) {
+    EnterScratchDir();
+    memset(&benchStore, 0, sizeof(benchStore));
+    pthread_mutex_init(&benchStore.lock, NULL);
+    benchStore.pendingSettings = (Settings){ 0.5f, 0.5f, true, COURSE_CLASSIC };
+}
+
+static void RunStoreSave(long long ops) {
+    for (long long i = 0; i < ops; i++) {
+        benchStore.pendingSettings.sfxVolume = (float)(i & 15) / 16.0f;
+        benchStore.settingsDirty = true;
+        WritePending(&benchStore);
+    }
+    benchSink = (float)benchStore.journalSize;
+}
+
+static void TeardownStoreSave(void) {
+    if (benchStore.journal) fclose(benchStore.journal);
+    benchStore.journal = NULL;
+    pthread_mutex_destroy(&benchStore.lock);
+    LeaveScratchDir();
+}
+
+static const Benchmark benchmarks[] = {
+    { "UpdateBird",      SetupBird,         RunUpdateBird,    NULL },
+    { "SpawnPipe",       SetupSpawnPipe,    RunSpawnPipe,     TeardownGame },
+    { "PipeLoop",        SetupRunningGame,  RunPipeLoop,      TeardownGame },
+    { "BirdCollision",   SetupRunningGame,  RunBirdCollision, TeardownGame },
+    { "UpdateGame",      SetupScriptedGame, RunScriptedTicks, TeardownScriptedGame },
+    { "StoreLoad",       SetupStoreLoad,    RunStoreLoad,     LeaveScratchDir },
+    { "StoreSave",       SetupStoreSave,    RunStoreSave,     TeardownStoreSave },
+    { "SaveSnapshot",    SetupRunningGame,  RunSaveSnapshot,  TeardownGame },
+    { "LoadSnapshot",    SetupLoadSnapshot, RunLoadSnapshot,  TeardownGame },
+    { "RewindPush",      SetupRewind,       RunRewindPush,    TeardownRewind },
+    { "RewindLoad",      SetupRewind,       RunRewindLoad,    TeardownRewind },
+};
+
+#define BENCHMARK_COUNT ((int)(sizeof(benchmarks) / sizeof(benchmarks[0])))
+
+// --- MEASUREMENT ---
+// One pass is rarely representative: a migration, a frequency change or another process
+// can slow every round in it. The suite is therefore run BENCH_REPEATS times in turn, each
+// benchmark reports its fastest pass (noise only ever adds time), and the gap between
+// that and its median pass is kept as a measure of how noisy the run was.
+typedef struct BenchResult {
+    char name[64];
+    double nsPerOp;         // fastest round of the fastest pass
+    double opsPerSec;
+    double allocsPerOp;
+    long long ops;          // per round
+    double spread;          // (median pass - fastest pass) / fastest, as a fraction
+    double passNs[BENCH_REPEATS];
+} BenchResult;
+
+// Doubles the op count until one round takes at least roundTime
+static long long Calibrate(const Benchmark *bench, double roundTime) {
+    long long ops = 1;
+    for (;;) {
+        double t0 = NowSeconds();
+        bench->run(ops);
+        if (NowSeconds() - t0 >= roundTime || ops >= (1LL << 40)) return ops;
+        ops *= 2;
+    }
+}
+
+// One pass: BENCH_ROUNDS rounds of result->ops, calibrating first if this is the first pass
+static void MeasurePass(const Benchmark *bench, double roundTime, int pass, BenchResult *result) {
+    if (bench->setup) bench->setup();
+    if (pass == 0) result->ops = Calibrate(bench, roundTime);
+
+    long long ops = result->ops;
+    long long allocsBefore = allocCount;
+    double best = 0.0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        double t0 = NowSeconds();
+        bench->run(ops);
+        double roundNs = (NowSeconds() - t0) * 1e9 / (double)ops;
+        if (r == 0 || roundNs < best) best = roundNs;
+    }
+    result->passNs[pass] = best;
+    result->allocsPerOp += (double)(allocCount - allocsBefore) / ((double)ops * BENCH_ROUNDS * BENCH_REPEATS);
+
+    if (bench->teardown) bench->teardown();
+}
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void FinishResult(const Benchmark *bench, BenchResult *result) {
+    double sorted[BENCH_REPEATS];
+    memcpy(sorted, result->passNs, sizeof(sorted));
+    qsort(sorted, BENCH_REPEATS, sizeof(double), CompareDoubles);
+
+    snprintf(result->name, sizeof(result->name), "%s", bench->name);
+    result->nsPerOp = sorted[0];
+    result->opsPerSec = 1e9 / result->nsPerOp;
+    result->spread = (sorted[BENCH_REPEATS / 2] - sorted[0]) / result->nsPerOp;
+}
+
+// --- RESULT FILES ---
+// One benchmark object per line, so the baseline can be read back without a JSON parser
+static bool SaveResults(const char *path, const BenchResult *results, int count) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"benchmarks\":[\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(file, "{\"name\":\"%s\",\"ns_per_op\":%.4f,\"ops_per_sec\":%.1f,\"allocs_per_op\":%.6f,\"ops\":%lld,\"spread\":%.4f}%s\n",
+                r->name, r->nsPerOp, r->opsPerSec, r->allocsPerOp, r->ops, r->spread, (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static int LoadResults(const char *path, BenchResult *results, int max) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+
+    int count = 0;
+    char line[512];
+    while (count < max && fgets(line, sizeof(line), file)) {
+        // Baselines written before the spread was recorded read as spread 0
+        BenchResult *r = &results[count];
+        r->spread = 0.0;
+        if (sscanf(line, "{\"name\":\"%63[^\"]\",\"ns_per_op\":%lf,\"ops_per_sec\":%lf,\"allocs_per_op\":%lf,\"ops\":%lld,\"spread\":%lf",
+                   r->name, &r->nsPerOp, &r->opsPerSec, &r->allocsPerOp, &r->ops, &r->spread) >= 5) {
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    const char *outFile = (argc > 1) ? argv[1] : "bench.json";
+    const char *baselineFile = (argc > 2) ? argv[2] : NULL;
+    double margin = ((argc > 3) ? atof(argv[3]) : 10.0) / 100.0;
+    double seconds = (argc > 4) ? atof(argv[4]) : 1.0;
+
+    BenchResult results[BENCH_MAX_RESULTS];
+    memset(results, 0, sizeof(results));
+    double roundTime = seconds / (BENCH_ROUNDS * BENCH_REPEATS);
+    for (int pass = 0; pass < BENCH_REPEATS; pass++) {
+        for (int i = 0; i < BENCHMARK_COUNT; i++) MeasurePass(&benchmarks[i], roundTime, pass, &results[i]);
+    }
+
+    printf("%-16s %12s %14s %12s %8s\n", "benchmark", "ns/op", "ops/s", "allocs/op", "spread");
+    for (int i = 0; i < BENCHMARK_COUNT; i++) {
+        FinishResult(&benchmarks[i], &results[i]);
+        printf("%-16s %12.2f %14.0f %12.4f %7.1f%%\n", results[i].name, results[i].nsPerOp,
+               results[i].opsPerSec, results[i].allocsPerOp, results[i].spread * 100.0);
+    }
+
+    if (!SaveResults(outFile, results, BENCHMARK_COUNT)) {
+        fprintf(stderr, "failed to write %s\n", outFile);
+        return 1;
+    }
+    printf("results:          %s\n", outFile);
+
+    if (baselineFile == NULL) return 0;
+
+    BenchResult baseline[BENCH_MAX_RESULTS];
+    int baselineCount = LoadResults(baselineFile, baseline, BENCH_MAX_RESULTS);
+    if (baselineCount < 0) {
+        fprintf(stderr, "failed to load baseline %s\n", baselineFile);
+        return 1;
+    }
+
+    // Slower than the margin allows, or any new allocation per op, is a regression. The
+    // spread never widens the margin; a benchmark that passes while either run's spread is
+    // wider than the margin is reported as too noisy to judge, so it can be rerun.
+    int regressions = 0;
+    int noisy = 0;
+    printf("baseline:         %s (margin %.0f%%)\n", baselineFile, margin * 100.0);
+    for (int i = 0; i < BENCHMARK_COUNT; i++) {
+        const BenchResult *now = &results[i];
+        for (int j = 0; j < baselineCount; j++) {
+            const BenchResult *base = &baseline[j];
+            if (strcmp(now->name, base->name) != 0) continue;
+
+            double change = now->nsPerOp / base->nsPerOp - 1.0;
+            double spread = (now->spread > base->spread) ? now->spread : base->spread;
+            bool slower = change > margin;
+            bool allocs = now->allocsPerOp > base->allocsPerOp + 1e-6;
+            bool unsure = !slower && !allocs && spread > margin;
+            printf("%-16s %+11.1f%% %s", now->name, change * 100.0,
+                   slower ? "REGRESSED" : allocs ? "REGRESSED (allocations)" : "ok");
+            if (unsure) printf(" (too noisy to judge: spread %.0f%%)", spread * 100.0);
+            printf("\n");
+            if (slower || allocs) regressions++;
+            if (unsure) noisy++;
+        }
+    }
+
+    if (noisy > 0) {
+        printf("warning: %d benchmark%s too noisy to judge at this margin; rerun on a quieter machine\n",
+               noisy, noisy == 1 ? " was" : "s were");
+    }
+    if (regressions > 0) {
+        printf("%d benchmark%s regressed\n", regressions, regressions == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+// tools/campaign.c
+// Plays a large seeded campaign of headless games across all cores with the
+// work-stealing runner. The checksum is identical for any thread count.
+//
+//   gcc tools/campaign.c src/runner.c src/bot.c src/game.c src/player.c src/course.c -Isrc -O2 -ffp-contract=off -pthread -lm -o flappy_campaign
+//   ./flappy_campaign [games] [threads] [seed] [maxTicks]
+
+#define _POSIX_C_SOURCE 199309L
+#include "game.h"
+#include "bot.h"
+#include "runner.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    Campaign campaign = {
+        .games    = (argc > 1) ? atoll(argv[1]) : 100000,
+        .threads  = (argc > 2) ? atoi(argv[2]) : 0,
+        .seed     = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : 1u,
+        .maxTicks = (argc > 4) ? atoi(argv[4]) : 0,
+        .bot      = AutopilotBot,
+        .botData  = NULL,
+        .progress = true
+    };
+    int threads = campaign.threads > 0 ? campaign.threads : DefaultThreadCount();
+
+    CampaignStats stats;
+    double start = NowSeconds();
+    if (!RunCampaign(&campaign, &stats)) {
+        fprintf(stderr, "campaign failed to start\n");
+        return 1;
+    }
+    double elapsed = NowSeconds() - start;
+
+    printf("games:        %lld on %d thread%s (seed %u)\n", stats.games, threads, threads == 1 ? "" : "s", campaign.seed);
+    printf("elapsed:      %.3f s\n", elapsed);
+    printf("throughput:   %.0f games/s, %.2f M ticks/s\n", stats.games / elapsed, stats.ticks / elapsed / 1e6);
+    printf("mean score:   %.3f\n", stats.games > 0 ? (double)stats.totalScore / stats.games : 0.0);
+    printf("best score:   %d\n", stats.bestScore);
+    printf("checksum:     %016llx\n", stats.checksum);
+
+    printf("scores:      ");
+    for (int b = 0; b < CAMPAIGN_HISTOGRAM; b++) {
+        if (stats.histogram[b] == 0) continue;
+        printf(" %d%s:%lld", b, b == CAMPAIGN_HISTOGRAM - 1 ? "+" : "", stats.histogram[b]);
+    }
+    printf("\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+// tools/headless.c
+// Runs the simulation core with no window or audio device and reports throughput.
+// With --courses it instead walks generated ENDLESS courses and fails on any pair of
+// pipes the bird can't get between, or any gap narrower than CourseMinGap.
+//
+//   gcc tools/headless.c src/bot.c src/game.c src/player.c src/course.c -Isrc -O2 -ffp-contract=off -lm -o flappy_headless
+//   ./flappy_headless [ticks] [dt] [seed]
+//   ./flappy_headless --courses [seeds] [segments per seed]
+
+#define _POSIX_C_SOURCE 199309L
+#include "game.h"
+#include "player.h"
+#include "bot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// --- COURSE CHECK ---
+// Every seed's course from its first pipe, through the difficulty ramp and well past it
+static int CheckCourses(unsigned int seeds, int segments) {
+    float minGap = CourseMinGap();
+    long long checked = 0;
+    long long narrow = 0;
+    long long unreachable = 0;
+
+    for (unsigned int seed = 1; seed <= seeds; seed++) {
+        Course course;
+        StartCourse(&course, COURSE_ENDLESS);
+        unsigned int rng = SeedRandom(seed);
+        PipeSegment from = NextCourseSegment(&course, &rng);
+
+        for (int i = 1; i < segments; i++) {
+            PipeSegment to = NextCourseSegment(&course, &rng);
+            bool gapOk = to.gapBottom - to.gapTop >= minGap - 0.5f;
+            bool reachOk = CourseTransitionReachable(&from, &to);
+            if (!gapOk) narrow++;
+            if (!reachOk) unreachable++;
+            if ((!gapOk || !reachOk) && narrow + unreachable <= 10) {
+                printf("seed %u pipe %d: gap %.1f-%.1f after %.1f-%.1f (%.2f s)%s%s\n", seed, i,
+                       to.gapTop, to.gapBottom, from.gapTop, from.gapBottom, from.spacing,
+                       gapOk ? "" : " too narrow", reachOk ? "" : " unreachable");
+            }
+            checked++;
+            from = to;
+        }
+    }
+
+    printf("transitions:  %lld (%u seeds x %d pipes, %s)\n", checked, seeds, segments, CourseName(COURSE_ENDLESS));
+    printf("min gap:      %.1f px\n", minGap);
+    printf("too narrow:   %lld\n", narrow);
+    printf("unreachable:  %lld\n", unreachable);
+    printf("check:        %s\n", (narrow + unreachable == 0) ? "OK" : "FAILED");
+    return (narrow + unreachable == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--courses") == 0) {
+        unsigned int seeds = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 10) : 10000u;
+        int segments = (argc > 3) ? atoi(argv[3]) : 400;
+        return CheckCourses(seeds, segments);
+    }
+
+    long long ticks = (argc > 1) ? atoll(argv[1]) : 10000000LL;
+    float dt = (argc > 2) ? (float)atof(argv[2]) : SIM_DT;
+
+    unsigned int seed = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : 1u;
+
+    Game game;
+    InitGame(&game, seed);
+
+    long long games = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+
+    double start = NowSeconds();
+
+    for (long long t = 0; t < ticks; t++) {
+        GameInput input;
+        AutopilotBot(&game, &input, NULL);
+
+        GameState before = game.state;
+        GameEvents events = { 0 };
+        UpdateGame(&game, &input, &events, dt);
+
+        if (before == GAME_RUNNING && game.state == GAME_OVER) {
+            games++;
+            totalScore += game.score;
+            if (game.score > bestScore) bestScore = game.score;
+        }
+    }
+
+    double elapsed = NowSeconds() - start;
+
+    printf("ticks:        %lld (dt %.5f s, %.1f sim-hours)\n", ticks, dt, ticks * dt / 3600.0);
+    printf("elapsed:      %.3f s\n", elapsed);
+    printf("throughput:   %.2f M ticks/s\n", elapsed > 0.0 ? ticks / elapsed / 1e6 : 0.0);
+    printf("games over:   %lld\n", games);
+    printf("mean score:   %.2f\n", games > 0 ? (double)totalScore / games : 0.0);
+    printf("best score:   %d\n", bestScore);
+
+    FreeGame(&game);
+    return 0;
+}
@@ -0,0 +1,40 @@
+// tools/pack.c
+// Decodes the loose assets once and writes them as a packed archive: the finished
+// RGBA atlas with the font glyphs baked in, glyph metrics and raw PCM. The game maps
+// the archive and uploads from it without decoding anything. Run it from the
+// repository root after changing anything in assets/.
+//
+//   gcc tools/pack.c src/assets.c src/archive.c src/atlas.c -Isrc -O2 -lraylib -lm -o flappy_pack
+//   ./flappy_pack [assets.pak]
+
+#include "assets.h"
+#include <stdio.h>
+
+int main(int argc, char **argv) {
+    const char *outFile = (argc > 1) ? argv[1] : ASSET_ARCHIVE;
+    SetTraceLogLevel(LOG_WARNING);
+
+    // No window here, so raylib's built-in font can't stand in for font.ttf
+    AssetData data;
+    if (!DecodeAssetFiles(&data, NULL)) {
+        fprintf(stderr, "failed to load assets/font.ttf\n");
+        return 1;
+    }
+
+    bool ok = SaveAssetArchive(&data, outFile);
+    if (ok) {
+        printf("atlas:        %dx%d RGBA (%d glyphs at %d px)\n",
+               data.atlas.width, data.atlas.height, data.font.glyphCount, data.font.baseSize);
+        for (int i = 0; i < SOUND_COUNT; i++) {
+            const Wave *wave = &data.sounds[i];
+            printf("sound %d:      %u frames, %u Hz, %u-bit, %u ch\n",
+                   i, wave->frameCount, wave->sampleRate, wave->sampleSize, wave->channels);
+        }
+        printf("written:      %s\n", outFile);
+    } else {
+        fprintf(stderr, "failed to write %s\n", outFile);
+    }
+
+    UnloadAssetData(&data);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+// tools/replay.c
+// Re-simulates a recorded run with no window, as fast as the CPU allows, and
+// checks that it reproduces the recorded outcome.
+//
+//   gcc tools/replay.c src/replay.c src/game.c src/player.c src/course.c -Isrc -O2 -ffp-contract=off -lm -o flappy_replay
+//   ./flappy_replay last_run.rpl [repeat]
+
+#define _POSIX_C_SOURCE 199309L
+#include "game.h"
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <replay.rpl> [repeat]\n", argv[0]);
+        return 2;
+    }
+
+    Replay replay;
+    if (!LoadReplay(&replay, argv[1])) {
+        fprintf(stderr, "failed to load replay %s\n", argv[1]);
+        return 2;
+    }
+
+    int repeat = (argc > 2) ? atoi(argv[2]) : 1;
+    if (repeat < 1) repeat = 1;
+
+    Game game = { 0 };
+    long long ticks = 0;
+    double start = NowSeconds();
+
+    for (int r = 0; r < repeat; r++) {
+        ReplayPlayer player;
+        FreeGame(&game);
+        InitGame(&game, 0);
+        StartReplay(&player, &replay, &game);
+
+        GameEvents events;
+        do {
+            events.count = 0;
+        } while (StepReplay(&player, &game, &events));
+        ticks += game.runTick;
+    }
+
+    double elapsed = NowSeconds() - start;
+    double simSeconds = ticks * SIM_DT;
+    bool match = (game.score == replay.finalScore && game.lives == replay.finalLives &&
+                  game.runTick == replay.tickCount);
+
+    printf("seed:         %u\n", replay.seed);
+    printf("ticks:        %d (%.1f s of play, %d flaps)\n", replay.tickCount, replay.tickCount * SIM_DT, replay.flapCount);
+    printf("recorded:     score %d, lives %d\n", replay.finalScore, replay.finalLives);
+    printf("replayed:     score %d, lives %d, state %s\n", game.score, game.lives,
+           game.state == GAME_OVER ? "GAME_OVER" : "RUNNING");
+    printf("speed:        %.0fx real time (%.3f s for %d pass%s)\n",
+           elapsed > 0.0 ? simSeconds / elapsed : 0.0, elapsed, repeat, repeat == 1 ? "" : "es");
+    printf("result:       %s\n", match ? "MATCH" : "MISMATCH");
+
+    FreeGame(&game);
+    FreeReplay(&replay);
+    return match ? 0 : 1;
+}
\ No newline at end of file
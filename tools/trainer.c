@@ -0,0 +1,243 @@
+// tools/trainer.c
+// Evolves Brain controllers with a simple genetic algorithm. Each generation
+// every genome plays the same seeded episodes on the real Game/UpdateGame
+// physics; tiles of genomes are spread over all cores by RunParallel and
+// step in lockstep so one batched forward pass serves a whole tile per tick.
+// The best genome is written after every generation and can be flown in-game
+// (press A with best.brain next to the executable).
+//
+//   gcc tools/trainer.c src/brain.c src/runner.c src/bot.c src/game.c src/player.c src/course.c -Isrc -O2 -march=native -ffp-contract=off -pthread -lm -o flappy_trainer
+//   ./flappy_trainer [population] [generations] [episodes] [threads] [seed] [out.brain]
+
+#define _POSIX_C_SOURCE 199309L
+#include "game.h"
+#include "brain.h"
+#include "runner.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRAIN_TILE          64          // genomes stepped together by one worker
+#define TRAIN_MAX_EPISODES  16
+#define TRAIN_MAX_TICKS     (int)(90 * SIM_TICK_RATE)
+#define TRAIN_ELITE         4
+#define TRAIN_TOURNAMENT    3
+#define MUTATION_RATE       0.10f
+#define MUTATION_SIGMA      0.30f
+
+typedef struct Trainer {
+    int population;
+    int episodes;
+    float *weights;                 // weights[k * population + g]
+    double *fitness;                // each tile writes only its own genomes
+    long long *scores;
+    long long *tileTicks;
+    unsigned int seeds[TRAIN_MAX_EPISODES];
+} Trainer;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static float RandomUniform(unsigned int *rng) {
+    return (NextRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+static float RandomGaussian(unsigned int *rng) {
+    float u = RandomUniform(rng) + 1e-7f;
+    float v = RandomUniform(rng);
+    return sqrtf(-2.0f * logf(u)) * cosf(2.0f * PI * v);
+}
+
+// --- EVALUATION ---
+static long long EvaluateTile(Trainer *t, int tile) {
+    int first = tile * TRAIN_TILE;
+    int count = (t->population - first < TRAIN_TILE) ? t->population - first : TRAIN_TILE;
+
+    // Local copy of the tile's weights, network index innermost (~27 KB)
+    static _Thread_local float weights[BRAIN_WEIGHTS * TRAIN_TILE];
+    static _Thread_local float inputs[BRAIN_INPUTS * TRAIN_TILE];
+    static _Thread_local Game games[TRAIN_TILE];
+    float outputs[TRAIN_TILE];
+    int ticks[TRAIN_TILE];
+
+    for (int k = 0; k < BRAIN_WEIGHTS; k++) {
+        memcpy(weights + k * TRAIN_TILE, t->weights + (size_t)k * t->population + first, count * sizeof(float));
+    }
+
+    long long totalTicks = 0;
+
+    for (int e = 0; e < t->episodes; e++) {
+        for (int g = 0; g < count; g++) {
+            InitGame(&games[g], t->seeds[e]);
+            ResetGame(&games[g], t->seeds[e]);
+            ticks[g] = 0;
+        }
+
+        int running = count;
+        for (int tick = 0; tick < TRAIN_MAX_TICKS && running > 0; tick++) {
+            for (int g = 0; g < count; g++) {
+                float in[BRAIN_INPUTS] = { 0 };
+                if (games[g].state != GAME_OVER) BrainInputs(&games[g], in);
+                for (int i = 0; i < BRAIN_INPUTS; i++) inputs[i * TRAIN_TILE + g] = in[i];
+            }
+
+            BrainForwardBatch(weights, inputs, TRAIN_TILE, count, outputs);
+
+            for (int g = 0; g < count; g++) {
+                Game *game = &games[g];
+                if (game->state == GAME_OVER) continue;
+
+                GameInput input = { .flap = outputs[g] > 0.0f };
+                GameEvents events;
+                events.count = 0;
+                UpdateGame(game, &input, &events, SIM_DT);
+                ticks[g]++;
+                if (game->state == GAME_OVER) running--;
+            }
+        }
+
+        // Pipes passed plus progress towards the next one
+        for (int g = 0; g < count; g++) {
+            t->fitness[first + g] += games[g].score + ticks[g] / (PIPE_SPAWN_TIME * SIM_TICK_RATE);
+            t->scores[first + g] += games[g].score;
+            totalTicks += ticks[g];
+            FreeGame(&games[g]);
+        }
+    }
+    return totalTicks;
+}
+
+static long long EvaluateTiles(long long first, long long last, int worker, void *user) {
+    Trainer *t = user;
+    long long ticks = 0;
+    (void)worker;
+
+    for (long long tile = first; tile < last; tile++) {
+        t->tileTicks[tile] = EvaluateTile(t, (int)tile);
+        ticks += t->tileTicks[tile];
+    }
+    return ticks;
+}
+
+// --- EVOLUTION ---
+static const Trainer *sortTrainer;
+
+// Best fitness first; index breaks ties so the order is fully deterministic
+static int CompareFitness(const void *a, const void *b) {
+    int ia = *(const int *)a, ib = *(const int *)b;
+    double fa = sortTrainer->fitness[ia], fb = sortTrainer->fitness[ib];
+    if (fa != fb) return (fa < fb) ? 1 : -1;
+    return ia - ib;
+}
+
+static int Tournament(const int *order, int population, unsigned int *rng) {
+    int best = population;
+    for (int i = 0; i < TRAIN_TOURNAMENT; i++) {
+        int pick = RandomRange(rng, 0, population - 1);
+        if (pick < best) best = pick;     // lower rank = fitter
+    }
+    return order[best];
+}
+
+static void Breed(const Trainer *t, const int *order, float *next, unsigned int *rng) {
+    int n = t->population;
+
+    for (int g = 0; g < n; g++) {
+        if (g < TRAIN_ELITE) {
+            for (int k = 0; k < BRAIN_WEIGHTS; k++) next[k * n + g] = t->weights[k * n + order[g]];
+            continue;
+        }
+
+        int a = Tournament(order, n, rng);
+        int b = Tournament(order, n, rng);
+        for (int k = 0; k < BRAIN_WEIGHTS; k++) {
+            float w = t->weights[k * n + ((NextRandom(rng) & 1) ? a : b)];
+            if (RandomUniform(rng) < MUTATION_RATE) w += RandomGaussian(rng) * MUTATION_SIGMA;
+            next[k * n + g] = w;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int population  = (argc > 1) ? atoi(argv[1]) : 512;
+    int generations = (argc > 2) ? atoi(argv[2]) : 50;
+    int episodes    = (argc > 3) ? atoi(argv[3]) : 4;
+    int threads     = (argc > 4) ? atoi(argv[4]) : 0;
+    unsigned int seed = (argc > 5) ? (unsigned int)strtoul(argv[5], NULL, 10) : 1u;
+    const char *outFile = (argc > 6) ? argv[6] : "best.brain";
+
+    if (population < TRAIN_ELITE + 1) population = TRAIN_ELITE + 1;
+    if (episodes < 1) episodes = 1;
+    if (episodes > TRAIN_MAX_EPISODES) episodes = TRAIN_MAX_EPISODES;
+
+    Trainer t = { .population = population, .episodes = episodes };
+    t.weights = malloc(sizeof(float) * BRAIN_WEIGHTS * population);
+    t.fitness = malloc(sizeof(double) * population);
+    t.scores = malloc(sizeof(long long) * population);
+    int tiles = (population + TRAIN_TILE - 1) / TRAIN_TILE;
+    t.tileTicks = malloc(sizeof(long long) * tiles);
+    float *next = malloc(sizeof(float) * BRAIN_WEIGHTS * population);
+    int *order = malloc(sizeof(int) * population);
+    if (!t.weights || !t.fitness || !t.scores || !t.tileTicks || !next || !order) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    unsigned int rng = SeedRandom(seed);
+    for (int k = 0; k < BRAIN_WEIGHTS * population; k++) {
+        t.weights[k] = RandomGaussian(&rng) * 0.5f;
+    }
+
+    printf("population %d x %d episodes, %d weights per genome, %d threads\n",
+           population, episodes, BRAIN_WEIGHTS, threads > 0 ? threads : DefaultThreadCount());
+
+    for (int gen = 0; gen < generations; gen++) {
+        // Every genome faces the same courses within a generation
+        for (int e = 0; e < episodes; e++) t.seeds[e] = NextRandom(&rng);
+        memset(t.fitness, 0, sizeof(double) * population);
+        memset(t.scores, 0, sizeof(long long) * population);
+
+        double start = NowSeconds();
+        RunParallel(tiles, threads, EvaluateTiles, &t, NULL);
+        double elapsed = NowSeconds() - start;
+
+        long long ticks = 0;
+        for (int i = 0; i < tiles; i++) ticks += t.tileTicks[i];
+
+        for (int g = 0; g < population; g++) order[g] = g;
+        sortTrainer = &t;
+        qsort(order, population, sizeof(int), CompareFitness);
+
+        double mean = 0.0;
+        for (int g = 0; g < population; g++) mean += t.fitness[g];
+        mean /= population;
+
+        Brain best;
+        for (int k = 0; k < BRAIN_WEIGHTS; k++) best.w[k] = t.weights[k * population + order[0]];
+        SaveBrain(&best, outFile);
+
+        printf("gen %3d  best %8.2f  mean %8.2f  best avg score %7.1f  %6.0f evals/s  %6.2f M ticks/s\n",
+               gen, t.fitness[order[0]] / episodes, mean / episodes,
+               (double)t.scores[order[0]] / episodes, population * episodes / elapsed, ticks / elapsed / 1e6);
+        fflush(stdout);
+
+        Breed(&t, order, next, &rng);
+        float *swap = t.weights;
+        t.weights = next;
+        next = swap;
+    }
+
+    printf("best genome written to %s\n", outFile);
+    free(t.weights);
+    free(t.fitness);
+    free(t.scores);
+    free(t.tileTicks);
+    free(next);
+    free(order);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+// tools/versus.c
+// One side of a versus match over loopback UDP, played by the autopilot with no window.
+// Start a host and a joiner as two processes; each sends through its own latency/loss
+// shim, and both print the rollback metrics and a checksum of the final state, which
+// must match.
+//
+//   gcc tools/versus.c src/versus.c src/net.c src/bot.c src/game.c src/player.c src/course.c -Isrc -O2 -ffp-contract=off -lm -o flappy_versus
+//   ./flappy_versus host 7000 7001 [latency ms] [jitter ms] [loss %] [ticks] [seed] &
+//   ./flappy_versus join 7001 7000 [latency ms] [jitter ms] [loss %] [ticks]
+
+#define _POSIX_C_SOURCE 199309L
+#include "versus.h"
+#include "net.h"
+#include "bot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VERSUS_SLIP         0.004f  // chance per tick that a bot flaps when it shouldn't
+#define VERSUS_LINGER       1.0     // seconds to keep answering the peer after the match
+#define VERSUS_TIMEOUT      10.0    // give up if the peer is silent this long
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void Nap(void) {
+    struct timespec nap = { 0, 500000 };
+    nanosleep(&nap, NULL);
+}
+
+// The autopilot with the odd slip, so the two sides play differently
+static bool BotFlap(const Game *game, unsigned int *rng) {
+    GameInput input;
+    AutopilotBot(game, &input, NULL);
+    if ((NextRandom(rng) & 0xFFFFFF) < (unsigned int)(VERSUS_SLIP * 16777216.0f)) return true;
+    return input.flap;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4 || (strcmp(argv[1], "host") != 0 && strcmp(argv[1], "join") != 0)) {
+        fprintf(stderr, "usage: %s host|join port peerPort [latency ms] [jitter ms] [loss %%] [ticks] [seed]\n", argv[0]);
+        return 2;
+    }
+    int side = (strcmp(argv[1], "host") == 0) ? 0 : 1;
+    int port = atoi(argv[2]);
+    int peerPort = atoi(argv[3]);
+    NetShim shim = { 0 };
+    shim.latencyMs = (argc > 4) ? atoi(argv[4]) : 0;
+    shim.jitterMs = (argc > 5) ? atoi(argv[5]) : 0;
+    shim.loss = (argc > 6) ? (float)atof(argv[6]) / 100.0f : 0.0f;
+    int maxTicks = (argc > 7) ? atoi(argv[7]) : 60 * (int)SIM_TICK_RATE;
+    unsigned int seed = (argc > 8) ? (unsigned int)strtoul(argv[8], NULL, 10) : (unsigned int)time(NULL);
+
+    NetLink link;
+    if (!OpenNetLink(&link, port, peerPort, &shim)) {
+        fprintf(stderr, "could not bind 127.0.0.1:%d\n", port);
+        return 1;
+    }
+
+    // The host picks the match; the joiner learns it from the host's first packet
+    VersusMatch *match = malloc(sizeof(VersusMatch));
+    bool started = side == 0;
+    if (started) InitVersus(match, seed, COURSE_CLASSIC, 0);
+    unsigned int botRng = SeedRandom(0xB07u + (unsigned int)side);
+
+    unsigned char packet[NET_MAX_PACKET];
+    double start = NowSeconds();
+    double heard = start;
+    double nextTick = start;
+    double doneAt = 0.0;
+    bool timedOut = false;
+
+    for (;;) {
+        int size;
+        while ((size = NetReceive(&link, packet, sizeof(packet))) > 0) {
+            if (!started) {
+                unsigned int hostSeed;
+                CourseCurve course;
+                int from;
+                if (!ReadVersusHeader(packet, size, &hostSeed, &course, &from) || from != 0) continue;
+                InitVersus(match, hostSeed, course, 1);
+                started = true;
+            }
+            if (ReceiveVersusPacket(match, packet, size)) heard = NowSeconds();
+        }
+
+        double now = NowSeconds();
+        if (now - heard > VERSUS_TIMEOUT) {
+            timedOut = true;
+            break;
+        }
+        if (now < nextTick) {
+            Nap();
+            continue;
+        }
+        nextTick += SIM_DT;
+        if (now - nextTick > MAX_FRAME_TIME) nextTick = now;
+        if (!started) continue;
+
+        if (doneAt == 0.0 && match->tick < maxTicks) {
+            bool flap = BotFlap(&match->players[side], &botRng);
+            AdvanceVersus(match, flap, NULL);
+        }
+        NetSend(&link, packet, WriteVersusPacket(match, packet));
+
+        SettleVersus(match);
+        bool capped = match->tick >= maxTicks && match->remoteTick >= maxTicks - 1;
+        if (doneAt == 0.0 && (VersusFinished(match) || capped)) doneAt = now;
+        if (doneAt > 0.0 && now - doneAt > VERSUS_LINGER) break;
+    }
+
+    if (!started) {
+        fprintf(stderr, "no host answered\n");
+        CloseNetLink(&link);
+        free(match);
+        return 1;
+    }
+
+    SettleVersus(match);
+    const VersusStats *stats = &match->stats;
+    double simSeconds = match->tick / SIM_TICK_RATE;
+    printf("side:          %s (seed %u, shim %d+-%d ms, %.0f%% loss)%s\n", side ? "join" : "host",
+           match->seed, shim.latencyMs, shim.jitterMs, shim.loss * 100.0f, timedOut ? ", peer timed out" : "");
+    printf("ticks:         %d (%.1f s), scores %d vs %d\n", match->tick, simSeconds,
+           match->players[0].score, match->players[1].score);
+    printf("stalls:        %lld\n", stats->stalls);
+    printf("rollbacks:     %lld (%.2f/s, %lld inputs mispredicted)\n", stats->rollbacks,
+           simSeconds > 0.0 ? stats->rollbacks / simSeconds : 0.0, stats->mispredicted);
+    printf("resimulated:   %lld ticks, deepest %d\n", stats->resimTicks, stats->maxRollback);
+    printf("resim cost:    %.2f us avg, %.2f us max per rollback\n",
+           stats->rollbacks > 0 ? stats->resimSeconds / stats->rollbacks * 1e6 : 0.0, stats->maxResimSeconds * 1e6);
+    printf("state checks:  %lld, %lld desynced\n", stats->checks, stats->desyncs);
+    printf("packets:       %lld sent, %lld received, %lld lost in the shim\n",
+           link.stats.sent, link.stats.received, link.stats.lost);
+    printf("checksum:      %08x\n", VersusChecksum(match));
+
+    bool failed = timedOut || stats->desyncs > 0;
+    FreeVersus(match);
+    free(match);
+    CloseNetLink(&link);
+    return failed ? 1 : 0;
+}